@@ -15,6 +15,7 @@
 #include "pa_sms_local.h"
 #include "pa_sim.h"
 #include "pa_sim_local.h"
+#include "pa_info_local.h"
 #include "pa_mdc.h"
 #include "pa_mdc_local.h"
 #include "pa_mcc_local.h"
@@ -37,10 +38,73 @@ static const char AtPortPath[] = "/dev/ttyACM0";
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Device path used for PPP session
+ * Device paths used for PPP sessions. Each concurrent data session uses its own port, so add a
+ * port (up to PA_AT_PPP_PORT_MAX) for each data session that must be up at the same time.
  */
 //--------------------------------------------------------------------------------------------------
-static const char PppPortPath[] = "/dev/ttyACM4";
+static const char* const PppPortPaths[] =
+{
+    "/dev/ttyACM4",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of PPP ports
+ */
+//--------------------------------------------------------------------------------------------------
+#define PPP_PORT_NB     (sizeof(PppPortPaths) / sizeof(PppPortPaths[0]))
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preferred storage of the SMS. ME storage (PA_SMS_STORAGE_NV) is much faster to access than SIM
+ * storage on most modules. PA_SMS_STORAGE_UNKNOWN keeps the modem configuration.
+ */
+//--------------------------------------------------------------------------------------------------
+static const pa_sms_Storage_t SmsStorage = PA_SMS_STORAGE_UNKNOWN;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * APN used to create a data profile which does not exist on the modem. Empty for none: the APN
+ * depends on the operator and is set by the integrator.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char MdcDefaultApn[] = "";
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reconnection policy of the data sessions dropped by the network. Disabled by default; when it is
+ * enabled, the delay between attempts doubles from initialDelayMs up to maxDelayMs, with jitter.
+ */
+//--------------------------------------------------------------------------------------------------
+static const pa_mdc_ReconnectPolicy_t MdcReconnectPolicy =
+{
+    .isEnabled      = false,
+    .initialDelayMs = 5000,
+    .maxDelayMs     = 600000,
+    .maxAttempts    = 0,
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cell monitoring command used to collect the neighbor cells
+ */
+//--------------------------------------------------------------------------------------------------
+static const pa_mrc_CellMonitorProfile_t MrcCellMonitorProfile = PA_MRC_CELL_MONITOR_CCED;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM slot selection command
+ */
+//--------------------------------------------------------------------------------------------------
+static const pa_sim_SlotSelectProfile_t SimSlotSelectProfile = PA_SIM_SLOT_SELECT_KSIMSEL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CMEE mode owned by the PA: 1 reports numeric +CME ERROR codes, 2 verbose ones. It is set once
+ * at startup and never changed afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+static const int32_t CmeeMode = 1;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -56,21 +120,7 @@ static le_result_t  EnableCmee
     void
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_FAULT;
-
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CMEE=1",
-                                        "\0",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res == LE_OK)
-    {
-        le_atClient_Delete(cmdRef);
-    }
-    return res;
+    return pa_utils_SetCmeeMode(CmeeMode);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -175,7 +225,25 @@ static le_result_t  SetNewSmsIndication()
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the preferred SMS storage, received messages included
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t  SetSmsStorage()
+{
+    if (PA_SMS_STORAGE_UNKNOWN == SmsStorage)
+    {
+        return LE_OK;
+    }
 
+    LE_DEBUG("Set preferred SMS storage %d", SmsStorage);
+    return pa_sms_SetPreferredStorage(SmsStorage, SmsStorage, SmsStorage);
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -205,6 +273,12 @@ static le_result_t SetDefaultConfig()
         return LE_FAULT;
     }
 
+    if (SetSmsStorage() != LE_OK)
+    {
+        LE_WARN("modem failed to set SMS storage");
+        return LE_FAULT;
+    }
+
     if (EnableCmee() != LE_OK)
     {
         LE_WARN("Failed to enable CMEE error");
@@ -231,7 +305,26 @@ char* __attribute__((weak)) pa_utils_GetPppPath
     void
 )
 {
-    return (char*)PppPortPath;
+    return (char*)PppPortPaths[0];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is used to get the path of a PPP port.
+ *
+ **/
+//--------------------------------------------------------------------------------------------------
+char* __attribute__((weak)) pa_utils_GetPppPathByIndex
+(
+    uint32_t portIndex
+)
+{
+    if ((portIndex >= PPP_PORT_NB) || (portIndex >= PA_AT_PPP_PORT_MAX))
+    {
+        return NULL;
+    }
+
+    return (char*)PppPortPaths[portIndex];
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -285,6 +378,7 @@ void __attribute__((weak)) pa_Init
 {
     le_atClient_DeviceRef_t atDeviceRef;
     le_atClient_DeviceRef_t pppDeviceRef;
+    uint32_t                portIndex;
     int                     fd = OpenAndConfigurePort(AtPortPath);
 
     if (fd < 0)
@@ -302,22 +396,25 @@ void __attribute__((weak)) pa_Init
     }
     pa_utils_SetAtDeviceRef(atDeviceRef);
 
-    fd = OpenAndConfigurePort(PppPortPath);
-
-    if (fd < 0)
+    for (portIndex = 0; (portIndex < PPP_PORT_NB) && (portIndex < PA_AT_PPP_PORT_MAX); portIndex++)
     {
-        LE_ERROR("Can't open %s", PppPortPath);
-        return;
-    }
+        fd = OpenAndConfigurePort(PppPortPaths[portIndex]);
 
-    pppDeviceRef = le_atClient_Start(fd);
+        if (fd < 0)
+        {
+            LE_ERROR("Can't open %s", PppPortPaths[portIndex]);
+            return;
+        }
 
-    if (pppDeviceRef == NULL)
-    {
-        LE_ERROR("Can't start %s, fd = %d", AtPortPath, fd);
-        return;
+        pppDeviceRef = le_atClient_Start(fd);
+
+        if (pppDeviceRef == NULL)
+        {
+            LE_ERROR("Can't start %s, fd = %d", PppPortPaths[portIndex], fd);
+            return;
+        }
+        pa_utils_SetPppDeviceRefByIndex(portIndex, pppDeviceRef);
     }
-    pa_utils_SetPppDeviceRef(pppDeviceRef);
 
     if (SetDefaultConfig() != LE_OK)
     {
@@ -325,10 +422,15 @@ void __attribute__((weak)) pa_Init
     }
     else
     {
+        pa_info_Init();
         pa_mrc_Init();
+        pa_mrc_local_SetCellMonitorProfile(MrcCellMonitorProfile);
         pa_sms_Init();
         pa_sim_Init();
+        pa_sim_local_SetSlotSelectProfile(SimSlotSelectProfile);
         pa_mdc_Init();
+        pa_mdc_SetReconnectPolicy(&MdcReconnectPolicy);
+        pa_mdc_SetDefaultApn(MdcDefaultApn);
         pa_mcc_Init();
         pa_ips_Init();
         pa_temp_Init();
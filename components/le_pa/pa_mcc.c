@@ -28,182 +28,499 @@ static le_event_HandlerRef_t  CallHandlerRef = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * AT call request reference
+ * Dial command reference, kept until the dialed call is set up or released
  */
 //--------------------------------------------------------------------------------------------------
 static le_atClient_CmdRef_t   AtCmdReqRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Identifier of the call set up by the dial command in progress
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t                DialCallId = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Final responses of the dial command
+ */
+//--------------------------------------------------------------------------------------------------
+#define DIAL_FINAL_RESPONSES    "OK|ERROR|+CME ERROR:|NO CARRIER|BUSY|NO ANSWER|NO DIALTONE"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of calls, the +CLCC call identifiers range from 1 to MAX_CALLS
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_CALLS               7
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * AT+CLCC polling period in milliseconds, used while calls are ongoing when the modem does not
+ * report the +CLCC unsolicited response
+ */
+//--------------------------------------------------------------------------------------------------
+#define CLCC_POLL_PERIOD_MS     1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * +CLCC call states. The states 0 to 5 are defined by 3GPP TS 27.007; the disconnect state is a
+ * vendor extension, only reported by the +CLCC unsolicited response when a call is released.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    CLCC_STAT_ACTIVE = 0,
+    CLCC_STAT_HELD,
+    CLCC_STAT_DIALING,
+    CLCC_STAT_ALERTING,
+    CLCC_STAT_INCOMING,
+    CLCC_STAT_WAITING,
+    CLCC_STAT_DISCONNECT,
+    CLCC_STAT_MAX
+}
+ClccStat_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call events, indexed by ClccStat_t
+ */
+//--------------------------------------------------------------------------------------------------
+static const le_mcc_Event_t ClccStatEvents[CLCC_STAT_MAX] =
+{
+    [CLCC_STAT_ACTIVE]     = LE_MCC_EVENT_CONNECTED,
+    [CLCC_STAT_HELD]       = LE_MCC_EVENT_ON_HOLD,
+    [CLCC_STAT_DIALING]    = LE_MCC_EVENT_ORIGINATING,
+    [CLCC_STAT_ALERTING]   = LE_MCC_EVENT_ALERTING,
+    [CLCC_STAT_INCOMING]   = LE_MCC_EVENT_INCOMING,
+    [CLCC_STAT_WAITING]    = LE_MCC_EVENT_WAITING,
+    [CLCC_STAT_DISCONNECT] = LE_MCC_EVENT_TERMINATED,
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Voice call context
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool                       inUse;               ///< Call ongoing
+    bool                       isSeen;              ///< Listed by the last AT+CLCC
+    bool                       isIncoming;          ///< Mobile terminated call
+    le_mcc_Event_t             event;               ///< Last reported event
+    le_mcc_TerminationReason_t terminationReason;   ///< Reason reported when the call ends
+    char                       phoneNumber[LE_MDMDEFS_PHONE_NUM_MAX_BYTES]; ///< Remote party
+}
+Call_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Voice calls, indexed by call identifier - 1
+ */
+//--------------------------------------------------------------------------------------------------
+static Call_t                 Calls[MAX_CALLS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether the modem reports the call state changes with the +CLCC unsolicited response
+ */
+//--------------------------------------------------------------------------------------------------
+static bool                   IsClccUnsolSupported = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer polling AT+CLCC when the +CLCC unsolicited response is not supported
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t         ClccPollTimerRef = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Unsolicited references
  */
 //--------------------------------------------------------------------------------------------------
-le_atClient_UnsolicitedResponseHandlerRef_t UnsolOkRef = NULL;
 le_atClient_UnsolicitedResponseHandlerRef_t UnsolNoCarrierRef = NULL;
 le_atClient_UnsolicitedResponseHandlerRef_t UnsolBusyRef = NULL;
 le_atClient_UnsolicitedResponseHandlerRef_t UnsolNoAnswerRef = NULL;
 le_atClient_UnsolicitedResponseHandlerRef_t UnsolRingRef = NULL;
 le_atClient_UnsolicitedResponseHandlerRef_t UnsolCringRef = NULL;
+le_atClient_UnsolicitedResponseHandlerRef_t UnsolClccRef = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to unregister all unsocilited.
- *
+ * End the tracking of the dial command in progress.
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void UnregisterDial
+static void EndDial
 (
     void
 )
 {
-    if (UnsolOkRef)
+    if (AtCmdReqRef)
     {
-        le_atClient_RemoveUnsolicitedResponseHandler(UnsolOkRef);
-        UnsolOkRef = NULL;
+        le_atClient_Delete(AtCmdReqRef);
+        AtCmdReqRef = NULL;
     }
+    DialCallId = 0;
+}
 
-    if (UnsolNoCarrierRef)
-    {
-        le_atClient_RemoveUnsolicitedResponseHandler(UnsolNoCarrierRef);
-        UnsolNoCarrierRef = NULL;
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a call event, only when the call state has changed. The call context is released once
+ * the call is terminated.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportCallEvent
+(
+    uint8_t        callId,      ///< [IN] Call identifier
+    le_mcc_Event_t event        ///< [IN] Call event
+)
+{
+    Call_t*                callPtr = &Calls[callId - 1];
+    pa_mcc_CallEventData_t callData;
 
-    if (UnsolBusyRef)
+    if (event == callPtr->event)
     {
-        le_atClient_RemoveUnsolicitedResponseHandler(UnsolBusyRef);
-        UnsolBusyRef = NULL;
+        return;
     }
 
-    if (UnsolNoAnswerRef)
+    LE_DEBUG("Call %d event %d -> %d", callId, callPtr->event, event);
+    callPtr->event = event;
+
+    if ((callId == DialCallId)
+        && (LE_MCC_EVENT_ORIGINATING != event) && (LE_MCC_EVENT_ALERTING != event))
     {
-        le_atClient_RemoveUnsolicitedResponseHandler(UnsolNoAnswerRef);
-        UnsolNoAnswerRef = NULL;
+        EndDial();
     }
 
-    if (AtCmdReqRef)
+    memset(&callData,0,sizeof(callData));
+    callData.callId = callId;
+    callData.event = event;
+    callData.terminationEvent = LE_MCC_TERM_UNDEFINED;
+    le_utf8_Copy(callData.phoneNumber, callPtr->phoneNumber, sizeof(callData.phoneNumber), NULL);
+
+    if (LE_MCC_EVENT_TERMINATED == event)
     {
-        le_mem_Release(AtCmdReqRef);
-        AtCmdReqRef = NULL;
+        callData.terminationEvent = callPtr->terminationReason;
+        memset(callPtr, 0, sizeof(Call_t));
     }
+
+    le_event_Report(CallEventId,&callData,sizeof(callData));
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to translate the code status for +CSSU parsing
+ * Update a call from a +CLCC line:
+ * +CLCC: <id>,<dir>,<stat>,<mode>,<mpty>[,<number>,<type>[,<alpha>]]
  *
- * @return true : eventPtr and terminationPtr are filled
- * @return false
+ * Non-voice calls are ignored.
  */
 //--------------------------------------------------------------------------------------------------
-static bool CheckCssuCode
+static void HandleClccLine
 (
-    const char*                 valuePtr,       ///< [IN] the value to change
-    le_mcc_Event_t*             eventPtr,       ///< [OUT] the event for CSSU
-    le_mcc_TerminationReason_t* terminationPtr  ///< [OUT] Termination reason
+    char* linePtr       ///< [IN/OUT] +CLCC line, parameters are isolated in place
 )
 {
-    bool result = true;
+    uint32_t numParam = pa_utils_CountAndIsolateLineParameters(linePtr);
+    int      callId;
+    int      stat;
+    Call_t*  callPtr;
 
-   *terminationPtr = LE_MCC_TERM_UNDEFINED;
-    switch (atoi(valuePtr))
+    if (numParam < 6)
     {
-        case 5: /* call on hold has been released (during a voice call) */
-        {
-            *eventPtr       = LE_MCC_EVENT_TERMINATED;
-            *terminationPtr = LE_MCC_TERM_REMOTE_ENDED;
-            break;
-        }
-        case 7:
+        LE_WARN("Unexpected +CLCC line");
+        return;
+    }
+
+    callId = atoi(pa_utils_IsolateLineParameter(linePtr, 2));
+    stat = atoi(pa_utils_IsolateLineParameter(linePtr, 4));
+    if ((callId < 1) || (callId > MAX_CALLS) || (stat < 0) || (stat >= CLCC_STAT_MAX))
+    {
+        LE_WARN("Unexpected call %d state %d", callId, stat);
+        return;
+    }
+
+    if (0 != atoi(pa_utils_IsolateLineParameter(linePtr, 5)))
+    {
+        LE_DEBUG("Call %d is not a voice call", callId);
+        return;
+    }
+
+    callPtr = &Calls[callId - 1];
+    if (!callPtr->inUse)
+    {
+        if (CLCC_STAT_DISCONNECT == stat)
         {
-            *eventPtr = LE_MCC_EVENT_ALERTING;
-            break;
+            return;
         }
-        default:
+
+        callPtr->inUse = true;
+        callPtr->isIncoming = (1 == atoi(pa_utils_IsolateLineParameter(linePtr, 3)));
+        callPtr->event = LE_MCC_EVENT_MAX;
+        callPtr->terminationReason = LE_MCC_TERM_REMOTE_ENDED;
+    }
+
+    if (numParam >= 7)
+    {
+        char* numberPtr = pa_utils_IsolateLineParameter(linePtr, 7);
+
+        pa_utils_RemoveQuotationString(numberPtr);
+        le_utf8_Copy(callPtr->phoneNumber, numberPtr, sizeof(callPtr->phoneNumber), NULL);
+    }
+
+    callPtr->isSeen = true;
+    ReportCallEvent(callId, ClccStatEvents[stat]);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the AT+CLCC polling while calls are ongoing, when the modem does not report the
+ * +CLCC unsolicited response.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateClccPolling
+(
+    void
+)
+{
+    bool isNeeded = false;
+    int  i;
+
+    for (i = 0; (i < MAX_CALLS) && (!IsClccUnsolSupported); i++)
+    {
+        if (Calls[i].inUse)
         {
-            result = false;
+            isNeeded = true;
         }
     }
-    return result;
+
+    if (isNeeded == le_timer_IsRunning(ClccPollTimerRef))
+    {
+        return;
+    }
+
+    if (isNeeded)
+    {
+        le_timer_Start(ClccPollTimerRef);
+    }
+    else
+    {
+        le_timer_Stop(ClccPollTimerRef);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function is a handler for call events.
+ * Synchronize the calls with the AT+CLCC list. The calls which are not listed anymore are
+ * terminated.
  *
+ * @return LE_FAULT         The function failed.
+ * @return LE_OK            The function succeeded.
  */
 //--------------------------------------------------------------------------------------------------
-static void PaMccUnsolHandler
+static le_result_t SyncCalls
 (
-    const char* unsolPtr,
-    void* contextPtr
+    void
 )
 {
-    pa_mcc_CallEventData_t callData;
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res;
+    char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    int                  i;
 
-    memset(&callData,0,sizeof(callData));
-    LE_DEBUG("Handler received -%s-",unsolPtr);
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        "AT+CLCC",
+                                        "+CLCC:",
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
+    {
+        LE_ERROR("Failed to send the command");
+        return LE_FAULT;
+    }
 
-    pa_utils_CountAndIsolateLineParameters( (char*) unsolPtr);
+    res = le_atClient_GetFinalResponse(cmdRef,
+                                       finalResponse,
+                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
+    if ((res != LE_OK) || (strcmp(finalResponse,"OK") != 0))
+    {
+        LE_ERROR("Failed to list the calls");
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
 
-    callData.terminationEvent = LE_MCC_TERM_UNDEFINED;
+    for (i = 0; i < MAX_CALLS; i++)
+    {
+        Calls[i].isSeen = false;
+    }
 
-    if ((FIND_STRING("OK",unsolPtr)))
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
+                                                   intermediateResponse,
+                                                   LE_ATDEFS_RESPONSE_MAX_BYTES);
+    while (res == LE_OK)
     {
-        callData.event = LE_MCC_EVENT_CONNECTED;
+        HandleClccLine(intermediateResponse);
+        res = le_atClient_GetNextIntermediateResponse(cmdRef,
+                                                      intermediateResponse,
+                                                      LE_ATDEFS_RESPONSE_MAX_BYTES);
+    }
+    le_atClient_Delete(cmdRef);
 
-        if (UnsolOkRef)
+    // The calls which are not listed anymore have been released
+    for (i = 0; i < MAX_CALLS; i++)
+    {
+        if ((Calls[i].inUse) && (!Calls[i].isSeen))
         {
-            le_atClient_RemoveUnsolicitedResponseHandler(UnsolOkRef);
-            UnsolOkRef = NULL;
+            ReportCallEvent(i + 1, LE_MCC_EVENT_TERMINATED);
         }
+    }
+
+    UpdateClccPolling();
+    return LE_OK;
+}
 
-        if (AtCmdReqRef)
+//--------------------------------------------------------------------------------------------------
+/**
+ * AT+CLCC polling timer handler.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClccPollTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    SyncCalls();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the termination reason of the outgoing calls being set up, from a dial final result code.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetDialTerminationReason
+(
+    le_mcc_TerminationReason_t reason   ///< [IN] Termination reason
+)
+{
+    int i;
+
+    for (i = 0; i < MAX_CALLS; i++)
+    {
+        if ((Calls[i].inUse) && (!Calls[i].isIncoming)
+            && ((LE_MCC_EVENT_ORIGINATING == Calls[i].event)
+                || (LE_MCC_EVENT_ALERTING == Calls[i].event)))
         {
-            le_mem_Release(AtCmdReqRef);
-            AtCmdReqRef = NULL;
+            Calls[i].terminationReason = reason;
         }
-        le_event_Report(CallEventId,&callData,sizeof(callData));
     }
-    else if ((FIND_STRING("NO CARRIER",unsolPtr)))
-    {
-        callData.event = LE_MCC_EVENT_TERMINATED;
-        callData.terminationEvent = LE_MCC_TERM_REMOTE_ENDED;
-        UnregisterDial();
-        le_event_Report(CallEventId,&callData,sizeof(callData));
-    }
-    else if ((FIND_STRING("BUSY",unsolPtr)) )
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the identifier of the outgoing call being set up.
+ *
+ * @return the call identifier, 0 if not found
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t GetDialingCallId
+(
+    void
+)
+{
+    int i;
+
+    for (i = 0; i < MAX_CALLS; i++)
     {
-        callData.event = LE_MCC_EVENT_TERMINATED;
-        callData.terminationEvent = LE_MCC_TERM_USER_BUSY;
-        UnregisterDial();
-        le_event_Report(CallEventId,&callData,sizeof(callData));
+        if ((Calls[i].inUse) && (!Calls[i].isIncoming)
+            && ((LE_MCC_EVENT_ORIGINATING == Calls[i].event)
+                || (LE_MCC_EVENT_ALERTING == Calls[i].event)))
+        {
+            return i + 1;
+        }
     }
-    else if ((FIND_STRING("NO ANSWER",unsolPtr)))
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a call is ongoing or being dialed.
+ *
+ * @return true if a call is ongoing
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsCallOngoing
+(
+    void
+)
+{
+    int i;
+
+    for (i = 0; i < MAX_CALLS; i++)
     {
-        callData.event = LE_MCC_EVENT_TERMINATED;
-        callData.terminationEvent = LE_MCC_TERM_REMOTE_ENDED;
-        UnregisterDial();
-        le_event_Report(CallEventId,&callData,sizeof(callData));
+        if (Calls[i].inUse)
+        {
+            return true;
+        }
     }
-    else if ((FIND_STRING("RING",unsolPtr)))
+
+    return (NULL != AtCmdReqRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is a handler for call events. The calls are tracked from the +CLCC lines, the
+ * other unsolicited responses only trigger a synchronization with AT+CLCC.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void PaMccUnsolHandler
+(
+    const char* unsolPtr,
+    void* contextPtr
+)
+{
+    char line[LE_ATDEFS_UNSOLICITED_MAX_BYTES];
+
+    LE_DEBUG("Handler received -%s-",unsolPtr);
+
+    if ((FIND_STRING("+CLCC:",unsolPtr)))
     {
-        callData.event = LE_MCC_EVENT_INCOMING;
-        le_event_Report(CallEventId,&callData,sizeof(callData));
+        le_utf8_Copy(line, unsolPtr, sizeof(line), NULL);
+        HandleClccLine(line);
     }
-    else if ((FIND_STRING("+CRING:",pa_utils_IsolateLineParameter(unsolPtr,1))))
+    else if ((FIND_STRING("NO CARRIER",unsolPtr)) || (FIND_STRING("BUSY",unsolPtr))
+             || (FIND_STRING("NO ANSWER",unsolPtr)))
     {
-        callData.event = LE_MCC_EVENT_INCOMING;
-        le_event_Report(CallEventId,&callData,sizeof(callData));
+        // Call progress codes only matter while a call is ongoing
+        if (!IsCallOngoing())
+        {
+            LE_DEBUG("No call ongoing, ignore -%s-",unsolPtr);
+            return;
+        }
+
+        if ((FIND_STRING("BUSY",unsolPtr)))
+        {
+            SetDialTerminationReason(LE_MCC_TERM_USER_BUSY);
+        }
+        SyncCalls();
     }
-    else if ((FIND_STRING("+CSSU:",pa_utils_IsolateLineParameter(unsolPtr,1))))
+    else if ((FIND_STRING("RING",unsolPtr)) || (FIND_STRING("+CRING:",unsolPtr)))
     {
-    if (CheckCssuCode(pa_utils_IsolateLineParameter(unsolPtr,2),
-        &(callData.event), &(callData.terminationEvent)))
+        // The incoming call is already reported by +CLCC when supported
+        if (!IsClccUnsolSupported)
         {
-            le_event_Report(CallEventId,&callData,sizeof(callData));
+            SyncCalls();
         }
     }
+    else if ((FIND_STRING("+CSSU:",unsolPtr)))
+    {
+        SyncCalls();
+    }
     else
     {
         LE_WARN("this pattern is not expected -%s-",unsolPtr);
@@ -225,6 +542,16 @@ le_result_t pa_mcc_Init
 {
     CallEventId = le_event_CreateId("CallEventId",sizeof(pa_mcc_CallEventData_t));
 
+    ClccPollTimerRef = le_timer_Create("ClccPollTimer");
+    le_timer_SetMsInterval(ClccPollTimerRef, CLCC_POLL_PERIOD_MS);
+    le_timer_SetRepeat(ClccPollTimerRef, 0);
+    le_timer_SetHandler(ClccPollTimerRef, ClccPollTimerHandler);
+
+    // Report the call state changes with the +CLCC unsolicited response. AT+CLCC=1 is a vendor
+    // extension, not defined by 3GPP TS 27.007: AT+CLCC is polled when it is not supported
+    IsClccUnsolSupported = (LE_OK == pa_utils_SendATCommandOK("AT+CLCC=1"));
+    LE_DEBUG("+CLCC unsolicited response %ssupported", IsClccUnsolSupported ? "" : "not ");
+
     return LE_OK;
 }
 
@@ -264,6 +591,30 @@ le_result_t pa_mcc_SetCallEventHandler
                                                                 NULL,
                                                                 1   );
 
+    UnsolClccRef = le_atClient_AddUnsolicitedResponseHandler(   "+CLCC:",
+                                                                pa_utils_GetAtDeviceRef(),
+                                                                PaMccUnsolHandler,
+                                                                NULL,
+                                                                1   );
+
+    UnsolNoCarrierRef = le_atClient_AddUnsolicitedResponseHandler(  "NO CARRIER",
+                                                                    pa_utils_GetAtDeviceRef(),
+                                                                    PaMccUnsolHandler,
+                                                                    NULL,
+                                                                    1   );
+
+    UnsolBusyRef = le_atClient_AddUnsolicitedResponseHandler(   "BUSY",
+                                                                pa_utils_GetAtDeviceRef(),
+                                                                PaMccUnsolHandler,
+                                                                NULL,
+                                                                1   );
+
+    UnsolNoAnswerRef = le_atClient_AddUnsolicitedResponseHandler(   "NO ANSWER",
+                                                                    pa_utils_GetAtDeviceRef(),
+                                                                    PaMccUnsolHandler,
+                                                                    NULL,
+                                                                    1   );
+
     CallHandlerRef = le_event_AddHandler("NewCallControlHandler",
                                              CallEventId,
                                              (le_event_HandlerFunc_t) handlerFuncPtr);
@@ -294,6 +645,30 @@ void pa_mcc_ClearCallEventHandler
         UnsolCringRef = NULL;
     }
 
+    if (UnsolClccRef)
+    {
+        le_atClient_RemoveUnsolicitedResponseHandler(UnsolClccRef);
+        UnsolClccRef = NULL;
+    }
+
+    if (UnsolNoCarrierRef)
+    {
+        le_atClient_RemoveUnsolicitedResponseHandler(UnsolNoCarrierRef);
+        UnsolNoCarrierRef = NULL;
+    }
+
+    if (UnsolBusyRef)
+    {
+        le_atClient_RemoveUnsolicitedResponseHandler(UnsolBusyRef);
+        UnsolBusyRef = NULL;
+    }
+
+    if (UnsolNoAnswerRef)
+    {
+        le_atClient_RemoveUnsolicitedResponseHandler(UnsolNoAnswerRef);
+        UnsolNoAnswerRef = NULL;
+    }
+
     //~le_atClient_RemoveUnsolicitedResponseHandler(UnsolCssuRef);
 
     le_event_RemoveHandler(CallHandlerRef);
@@ -319,6 +694,7 @@ le_result_t pa_mcc_VoiceDial
 )
 {
     char                 command[LE_ATDEFS_COMMAND_MAX_BYTES];
+    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
     le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_FAULT;
 
@@ -335,44 +711,49 @@ le_result_t pa_mcc_VoiceDial
              (clir==PA_MCC_DEACTIVATE_CLIR)?'i':'I',
              (cug==PA_MCC_ACTIVATE_CUG)?'g':'G');
 
-    UnsolOkRef = le_atClient_AddUnsolicitedResponseHandler( "OK",
-                                                            pa_utils_GetAtDeviceRef(),
-                                                            PaMccUnsolHandler,
-                                                            NULL,
-                                                            1 );
-
-    UnsolNoCarrierRef = le_atClient_AddUnsolicitedResponseHandler(  "NO CARRIER",
-                                                                    pa_utils_GetAtDeviceRef(),
-                                                                    PaMccUnsolHandler,
-                                                                    NULL,
-                                                                    1   );
-
-
-    UnsolBusyRef = le_atClient_AddUnsolicitedResponseHandler(   "BUSY",
-                                                                pa_utils_GetAtDeviceRef(),
-                                                                PaMccUnsolHandler,
-                                                                NULL,
-                                                                1   );
-
-    UnsolNoAnswerRef = le_atClient_AddUnsolicitedResponseHandler(   "NO ANSWER",
-                                                                    pa_utils_GetAtDeviceRef(),
-                                                                    PaMccUnsolHandler,
-                                                                    NULL,
-                                                                    1   );
-
+    *callIdPtr = 0;
 
     res = le_atClient_SetCommandAndSend(&cmdRef,
                                         pa_utils_GetAtDeviceRef(),
                                         (char*)command,
                                         "",
-                                        DEFAULT_AT_RESPONSE,
+                                        DIAL_FINAL_RESPONSES,
                                         DEFAULT_AT_CMD_TIMEOUT);
-    *callIdPtr = 0;
-    if (res == LE_OK)
+    if (res != LE_OK)
+    {
+        LE_ERROR("Failed to send the command");
+        return res;
+    }
+
+    res = le_atClient_GetFinalResponse(cmdRef,
+                                       finalResponse,
+                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
+    if ((res != LE_OK) || (strcmp(finalResponse,"OK") != 0))
     {
+        LE_ERROR("Failed to dial: %s", (res == LE_OK) ? finalResponse : "no response");
+        if ((errorPtr) && (res == LE_OK))
+        {
+            *errorPtr = (FIND_STRING("BUSY",finalResponse)) ? LE_MCC_TERM_USER_BUSY :
+                        (FIND_STRING("NO CARRIER",finalResponse)) ? LE_MCC_TERM_REMOTE_ENDED :
+                        (FIND_STRING("NO ANSWER",finalResponse)) ? LE_MCC_TERM_REMOTE_ENDED :
+                        (FIND_STRING("NO DIALTONE",finalResponse)) ? LE_MCC_TERM_NETWORK_FAIL :
+                                                                     LE_MCC_TERM_UNDEFINED;
+        }
         le_atClient_Delete(cmdRef);
+        return LE_FAULT;
     }
-    return res;
+
+    // The dial is tracked by its command until the call is set up or released
+    AtCmdReqRef = cmdRef;
+    SyncCalls();
+    DialCallId = GetDialingCallId();
+    if (0 == DialCallId)
+    {
+        EndDial();
+    }
+
+    *callIdPtr = DialCallId;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -392,18 +773,6 @@ le_result_t pa_mcc_Answer
     le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_FAULT;
 
-    if (AtCmdReqRef)
-    {
-        le_mem_Release(AtCmdReqRef);   // Release e_le_atClient_mgr_Object_CreateATCommand
-        AtCmdReqRef = NULL;
-    }
-
-    UnsolNoCarrierRef = le_atClient_AddUnsolicitedResponseHandler( "NO CARRIER",
-                                                                   pa_utils_GetAtDeviceRef(),
-                                                                   PaMccUnsolHandler,
-                                                                   NULL,
-                                                                   1 );
-
     res = le_atClient_SetCommandAndSend(&cmdRef,
                                         pa_utils_GetAtDeviceRef(),
                                         "ATA",
@@ -412,19 +781,45 @@ le_result_t pa_mcc_Answer
                                         DEFAULT_AT_CMD_TIMEOUT);
     if (res == LE_OK)
     {
-        pa_mcc_CallEventData_t callData;
-        memset(&callData,0,sizeof(callData));
-        callData.event = LE_MCC_EVENT_CONNECTED;
-        le_event_Report(CallEventId,&callData,sizeof(callData));
         le_atClient_Delete(cmdRef);
+        SyncCalls();
     }
     return res;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a call is the only call tracked.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsOnlyCall
+(
+    uint8_t callId     ///< [IN] Call identifier
+)
+{
+    int i;
+
+    for (i = 0; i < MAX_CALLS; i++)
+    {
+        if ((Calls[i].inUse) && (i != callId - 1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to disconnect the remote user.
  *
+ * The release command depends on the call state, leaving the other calls untouched:
+ * - an active or held call is released with AT+CHLD=1<callId>,
+ * - a dialing, alerting or incoming call is released with ATH,
+ * - a waiting call is rejected with AT+CHLD=0.
+ * ATH is used when AT+CHLD is rejected and the call is the only one.
+ *
  * @return LE_FAULT         The function failed.
  * @return LE_TIMEOUT       No response was received.
  * @return LE_OK            The function succeeded.
@@ -435,7 +830,70 @@ le_result_t pa_mcc_HangUp
     uint8_t callId     ///< [IN] The call ID to hangup
 )
 {
-    return pa_mcc_HangUpAll();
+    char                       command[PA_AT_LOCAL_SHORT_SIZE];
+    le_mcc_TerminationReason_t reason;
+    le_result_t                res;
+    bool                       isChld = true;
+    int                        i;
+
+    if ((callId < 1) || (callId > MAX_CALLS) || (!Calls[callId - 1].inUse))
+    {
+        for (i = 0; i < MAX_CALLS; i++)
+        {
+            if (Calls[i].inUse)
+            {
+                LE_ERROR("Unknown call %d", callId);
+                return LE_FAULT;
+            }
+        }
+
+        // No call is tracked, e.g. the dial did not return any call identifier
+        return pa_mcc_HangUpAll();
+    }
+
+    switch (Calls[callId - 1].event)
+    {
+        case LE_MCC_EVENT_ORIGINATING:
+        case LE_MCC_EVENT_ALERTING:
+        case LE_MCC_EVENT_INCOMING:
+            le_utf8_Copy(command, "ATH", sizeof(command), NULL);
+            isChld = false;
+            break;
+
+        case LE_MCC_EVENT_WAITING:
+            le_utf8_Copy(command, "AT+CHLD=0", sizeof(command), NULL);
+            break;
+
+        default:
+            snprintf(command, sizeof(command), "AT+CHLD=1%d", callId);
+            break;
+    }
+
+    reason = Calls[callId - 1].terminationReason;
+    Calls[callId - 1].terminationReason = LE_MCC_TERM_LOCAL_ENDED;
+
+    res = pa_utils_SendATCommandOK(command);
+    if ((LE_OK != res) && (isChld) && (IsOnlyCall(callId)))
+    {
+        LE_WARN("%s rejected, release call %d with ATH", command, callId);
+        isChld = false;
+        res = pa_utils_SendATCommandOK("ATH");
+    }
+
+    if (LE_OK != res)
+    {
+        LE_ERROR("Failed to release call %d", callId);
+        Calls[callId - 1].terminationReason = reason;
+        return LE_FAULT;
+    }
+
+    if ((!isChld) && (callId == DialCallId))
+    {
+        EndDial();
+    }
+
+    SyncCalls();
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -454,8 +912,17 @@ le_result_t pa_mcc_HangUpAll
 {
     le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_FAULT;
+    int                  i;
 
-    UnregisterDial();
+    EndDial();
+
+    for (i = 0; i < MAX_CALLS; i++)
+    {
+        if (Calls[i].inUse)
+        {
+            Calls[i].terminationReason = LE_MCC_TERM_LOCAL_ENDED;
+        }
+    }
 
     res = le_atClient_SetCommandAndSend(&cmdRef,
                                         pa_utils_GetAtDeviceRef(),
@@ -465,12 +932,8 @@ le_result_t pa_mcc_HangUpAll
                                         DEFAULT_AT_CMD_TIMEOUT);
     if (res == LE_OK)
     {
-        pa_mcc_CallEventData_t callData;
-        memset(&callData,0,sizeof(callData));
-        callData.event = LE_MCC_EVENT_TERMINATED;
-        callData.terminationEvent = LE_MCC_TERM_LOCAL_ENDED;
-        le_event_Report(CallEventId,&callData,sizeof(callData));
         le_atClient_Delete(cmdRef);
+        SyncCalls();
     }
     return res;
 }
@@ -10,117 +10,983 @@
 #include "legato.h"
 
 #include "pa_mdc.h"
+#include "pa_mrc.h"
 #include "pa_utils.h"
 #include "pa_mdc_local.h"
 #include "pa_mdc_utils_local.h"
+#include "pa_mrc_local.h"
 
 #if LE_CONFIG_LINUX
 #include <sys/ioctl.h>
 #include <termios.h>
 #include <stdio.h>
 #include <netinet/in.h>
-#include <arpa/nameser.h>
 #include <arpa/inet.h>
-#include <resolv.h>
 #endif
 
 #include <sys/wait.h>
+#include <poll.h>
+#include <ctype.h>
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Call event ID
+ * Define an invalid profile index. Since profile indices start at 1, 0 is an invalid index.
+ */
+//--------------------------------------------------------------------------------------------------
+#define INVALID_PROFILE_INDEX       0
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum time allowed to pppd for the PPP negotiation (LCP, authentication and IPCP), in ms.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PPP_NEGOTIATION_TIMEOUT     30000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer used to collect the pppd log lines.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PPP_LOG_LINE_MAX_BYTES      256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kernel counters of a network interface, relative to the interface directory in sysfs.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SYSFS_NET_PATH              "/sys/class/net"
+#define SYSFS_RX_BYTES              "statistics/rx_bytes"
+#define SYSFS_TX_BYTES              "statistics/tx_bytes"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of session state reports that can be pending at the same time.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SESSION_STATE_POOL_SIZE     (2 * PA_AT_PPP_PORT_MAX)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Define a static pool for session state.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(SessionStatePool, SESSION_STATE_POOL_SIZE,
+                          sizeof(pa_mdc_SessionStateData_t));
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data session of a profile. The PDP context is connected through its own PPP port, on which a
+ * pppd process is supervised on the event loop. pppd runs in the foreground ("nodetach") and logs
+ * on a pipe which is monitored to follow the negotiation progress; its termination is caught with
+ * SIGCHLD.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t               profileIndex;                    ///< Profile of the session
+    le_mdc_ConState_t      state;                           ///< Session state
+    uint32_t               portIndex;                       ///< PPP port used by the session
+    char                   interfaceName[LE_MDC_INTERFACE_NAME_MAX_BYTES]; ///< PPP interface
+    pid_t                  pid;                             ///< pppd pid, 0 when not running
+    int                    logFd;                           ///< Read end of the pppd log pipe
+    le_fdMonitor_Ref_t     logMonitorRef;                   ///< pppd log pipe monitor
+    le_timer_Ref_t         timerRef;                        ///< Negotiation timer
+    char                   logLine[PPP_LOG_LINE_MAX_BYTES]; ///< Log line being collected
+    size_t                 logLineLen;                      ///< Length of the collected log line
+    pa_mdc_PktStatistics_t lastSample;                      ///< Last sample of the kernel counters
+    bool                   isAutoReconnect;                 ///< Reconnect if dropped by network
+    bool                   wasConnected;                    ///< Connected since started on request
+    bool                   isReconnecting;                  ///< A reconnection is in progress
+    uint32_t               reconnectAttempt;                ///< Attempts of the reconnection
+    le_timer_Ref_t         reconnectTimerRef;               ///< Reconnection backoff timer
+    pa_mdc_ReconnectCounters_t reconnectCounters;           ///< Reconnection counters
+}
+DataSession_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * APN written by pa_mdc_InitializeProfile when the profile does not exist, empty for none
+ */
+//--------------------------------------------------------------------------------------------------
+static char DefaultApn[PA_MDC_APN_MAX_BYTES] = "";
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reconnection policy of the data sessions dropped by the network, disabled by default
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_mdc_ReconnectPolicy_t ReconnectPolicy = { .isEnabled = false };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This event is reported when a data session state change is received from the modem.  The
+ * report data is allocated from the associated pool.   Only one event handler is allowed to be
+ * registered at a time, so its reference is stored, in case it needs to be removed later.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t         SessionStateEventId;
+static le_mem_PoolRef_t      SessionStatePool;
+static le_event_HandlerRef_t NewSessionStateHandlerRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data sessions, indexed by profile index. Several profiles can be connected at the same time,
+ * as long as a PPP port is available for each of them.
+ */
+//--------------------------------------------------------------------------------------------------
+static DataSession_t DataSessions[PA_MDC_MAX_PROFILE + 1];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data flow counters. The kernel counters of the PPP interfaces restart from zero each time an
+ * interface is created, so they are sampled and their increments are accumulated:
+ *  - totalCount counts the data since the last reset,
+ *  - statisticsCount counts the data since the last reset while the collection is started.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pa_mdc_PktStatistics_t totalCount;          ///< Data flow since the last reset
+    pa_mdc_PktStatistics_t statisticsCount;     ///< Collected data flow since the last reset
+    bool                   isCollecting;        ///< Data flow statistics collection is started
+}
+DataFlowCounters_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The data flow counters
+ */
+//--------------------------------------------------------------------------------------------------
+static DataFlowCounters_t DataFlowCounters = { .isCollecting = true };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited references
+ */
+//--------------------------------------------------------------------------------------------------
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCgevRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex used to protect access to the data session states.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // POSIX "Fast" mutex.
+
+/// Locks the mutex.
+#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0)
+
+/// Unlocks the mutex.
+#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the data session of a profile
+ *
+ * @return
+ *      The data session, NULL if the profile index is not valid
+ */
+//--------------------------------------------------------------------------------------------------
+static DataSession_t* GetDataSession
+(
+    uint32_t profileIndex    ///< [IN] The profile identifier
+)
+{
+    if ((INVALID_PROFILE_INDEX == profileIndex) || (profileIndex > PA_MDC_MAX_PROFILE))
+    {
+        return NULL;
+    }
+
+    return &DataSessions[profileIndex];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the state of a data session, ensuring that access is protected by a mutex
+ *
+ * @return
+ *      The session state
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_mdc_ConState_t GetDataSessionState
+(
+    DataSession_t* sessionPtr      ///< [IN] The data session
+)
+{
+    le_mdc_ConState_t state;
+
+    LOCK;
+    state = sessionPtr->state;
+    UNLOCK;
+
+    return state;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the state of a data session, ensuring that access is protected by a mutex
+ *
+ * @return
+ *      true if the state has changed
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool SetDataSessionState
+(
+    DataSession_t*    sessionPtr,   ///< [IN] The data session
+    le_mdc_ConState_t newState      ///< [IN] The new session state
+)
+{
+    bool isChanged;
+
+    LOCK;
+    isChanged = (sessionPtr->state != newState);
+    sessionPtr->state = newState;
+    UNLOCK;
+
+    return isChanged;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the Packet Domain service attach state.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetPSAttachState
+(
+    bool* isAttachedPtr         ///< [OUT] The PS attach state
+)
+{
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res;
+    char                 responseStr[PA_AT_LOCAL_SHORT_SIZE] = {0};
+
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        "AT+CGATT?",
+                                        "+CGATT:",
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
+    {
+        return res;
+    }
+
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    if ((res != LE_OK) || (strcmp(responseStr, "OK") != 0))
+    {
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
+
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    le_atClient_Delete(cmdRef);
+    if ((res != LE_OK) || (pa_utils_CountAndIsolateLineParameters(responseStr) < 2))
+    {
+        return LE_FAULT;
+    }
+
+    *isAttachedPtr = (1 == atoi(pa_utils_IsolateLineParameter(responseStr, 2)));
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Schedule the next reconnection attempt of a data session, with an exponential backoff and a
+ * random jitter so that devices dropped at the same time do not reconnect all at once.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScheduleReconnect
+(
+    DataSession_t* sessionPtr   ///< [IN] The data session
+)
+{
+    uint32_t delayMs = ReconnectPolicy.initialDelayMs;
+    uint32_t i;
+
+    if ((ReconnectPolicy.maxAttempts) &&
+        (sessionPtr->reconnectAttempt >= ReconnectPolicy.maxAttempts))
+    {
+        LE_WARN("Reconnection of profile %"PRIu32" given up after %"PRIu32" attempts",
+                sessionPtr->profileIndex, sessionPtr->reconnectAttempt);
+        sessionPtr->reconnectCounters.abandonCount++;
+        sessionPtr->isAutoReconnect = false;
+        sessionPtr->wasConnected = false;
+        sessionPtr->isReconnecting = false;
+        return;
+    }
+
+    for (i = 0; (i < sessionPtr->reconnectAttempt) && (delayMs < ReconnectPolicy.maxDelayMs); i++)
+    {
+        delayMs *= 2;
+    }
+    if (delayMs > ReconnectPolicy.maxDelayMs)
+    {
+        delayMs = ReconnectPolicy.maxDelayMs;
+    }
+    delayMs = delayMs / 2 + le_rand_GetNumBetween(0, delayMs / 2);
+
+    LE_INFO("Reconnection of profile %"PRIu32" in %"PRIu32" ms",
+            sessionPtr->profileIndex, delayMs);
+
+    sessionPtr->isReconnecting = true;
+    le_timer_Stop(sessionPtr->reconnectTimerRef);
+    le_timer_SetMsInterval(sessionPtr->reconnectTimerRef, delayMs);
+    le_timer_Start(sessionPtr->reconnectTimerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reconnection timer handler: restart the data session once the modem is registered and attached
+ * to the Packet Domain service.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReconnectTimerHandler
+(
+    le_timer_Ref_t timerRef     ///< [IN] Reconnection timer
+)
+{
+    DataSession_t*       sessionPtr = le_timer_GetContextPtr(timerRef);
+    le_mrc_NetRegState_t regState = LE_MRC_REG_UNKNOWN;
+    bool                 isAttached = false;
+
+    if ((!sessionPtr->isAutoReconnect) || (!sessionPtr->isReconnecting))
+    {
+        return;
+    }
+
+    // The previous pppd is still terminating: the attempt is postponed, not consumed
+    if ((sessionPtr->pid) || (LE_MDC_DISCONNECTED != GetDataSessionState(sessionPtr)))
+    {
+        le_timer_Start(timerRef);
+        return;
+    }
+
+    if ((pa_mrc_GetNetworkRegState(&regState) != LE_OK) ||
+        ((LE_MRC_REG_HOME != regState) && (LE_MRC_REG_ROAMING != regState)))
+    {
+        LE_DEBUG("Not registered, reconnection of profile %"PRIu32" postponed",
+                 sessionPtr->profileIndex);
+        le_timer_Start(timerRef);
+        return;
+    }
+
+    if ((GetPSAttachState(&isAttached) != LE_OK) || (!isAttached))
+    {
+        LE_DEBUG("Not attached, reconnection of profile %"PRIu32" postponed",
+                 sessionPtr->profileIndex);
+        pa_mdc_utils_AttachPS(true);
+        le_timer_Start(timerRef);
+        return;
+    }
+
+    sessionPtr->reconnectAttempt++;
+    sessionPtr->reconnectCounters.attemptCount++;
+
+    LE_INFO("Reconnection attempt %"PRIu32" of profile %"PRIu32,
+            sessionPtr->reconnectAttempt, sessionPtr->profileIndex);
+
+    if (pa_mdc_StartSessionIPV4(sessionPtr->profileIndex) != LE_OK)
+    {
+        sessionPtr->reconnectCounters.failureCount++;
+        ScheduleReconnect(sessionPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the reconnection of a data session on a state change.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateReconnect
+(
+    DataSession_t*    sessionPtr,   ///< [IN] The data session
+    le_mdc_ConState_t newState      ///< [IN] The new session state
+)
+{
+    if (LE_MDC_CONNECTED == newState)
+    {
+        if (sessionPtr->isReconnecting)
+        {
+            LE_INFO("Profile %"PRIu32" reconnected after %"PRIu32" attempts",
+                    sessionPtr->profileIndex, sessionPtr->reconnectAttempt);
+            sessionPtr->reconnectCounters.successCount++;
+        }
+        sessionPtr->isReconnecting = false;
+        sessionPtr->reconnectAttempt = 0;
+        sessionPtr->wasConnected = sessionPtr->isAutoReconnect;
+    }
+    else if ((LE_MDC_DISCONNECTED == newState) && (sessionPtr->isAutoReconnect) &&
+             (sessionPtr->wasConnected) && (ReconnectPolicy.isEnabled))
+    {
+        if (sessionPtr->isReconnecting)
+        {
+            sessionPtr->reconnectCounters.failureCount++;
+        }
+        else
+        {
+            sessionPtr->reconnectAttempt = 0;
+        }
+        ScheduleReconnect(sessionPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the state of a data session and report it to the session state handler when it changes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportSessionState
+(
+    DataSession_t*    sessionPtr,   ///< [IN] The data session
+    le_mdc_ConState_t newState      ///< [IN] The new session state
+)
+{
+    pa_mdc_SessionStateData_t* sessionStatePtr;
+
+    if (!SetDataSessionState(sessionPtr, newState))
+    {
+        return;
+    }
+
+    // The dynamic parameters of the context are read again after each state change
+    pa_mdc_utils_InvalidateIpParam(sessionPtr->profileIndex);
+
+    sessionStatePtr = le_mem_ForceAlloc(SessionStatePool);
+    memset(sessionStatePtr, 0, sizeof(pa_mdc_SessionStateData_t));
+    sessionStatePtr->profileIndex = sessionPtr->profileIndex;
+    sessionStatePtr->newState = newState;
+
+    LE_DEBUG("Send Event for %" PRIu32 " with state %d",
+             sessionStatePtr->profileIndex,
+             sessionStatePtr->newState);
+    le_event_ReportWithRefCounting(SessionStateEventId,sessionStatePtr);
+
+    UpdateReconnect(sessionPtr, newState);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a free PPP port for a new data session.
+ *
+ * @return LE_OK            A port is allocated
+ * @return LE_NO_MEMORY     All the PPP ports are in use
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AllocatePppPort
+(
+    uint32_t* portIndexPtr   ///< [OUT] The PPP port index
+)
+{
+    uint32_t portIndex;
+    uint32_t profileIndex;
+    bool     isUsed;
+
+    for (portIndex = 0; portIndex < PA_AT_PPP_PORT_MAX; portIndex++)
+    {
+        if (NULL == pa_utils_GetPppDeviceRefByIndex(portIndex))
+        {
+            continue;
+        }
+
+        isUsed = false;
+        for (profileIndex = 1; profileIndex <= PA_MDC_MAX_PROFILE; profileIndex++)
+        {
+            DataSession_t* sessionPtr = &DataSessions[profileIndex];
+
+            if ((sessionPtr->portIndex == portIndex) &&
+                ((sessionPtr->pid) || (LE_MDC_DISCONNECTED != GetDataSessionState(sessionPtr))))
+            {
+                isUsed = true;
+                break;
+            }
+        }
+
+        if (!isUsed)
+        {
+            *portIndexPtr = portIndex;
+            return LE_OK;
+        }
+    }
+
+    LE_ERROR("No PPP port available");
+    return LE_NO_MEMORY;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a kernel counter of a PPP interface.
+ *
+ * @return
+ *      The counter value, 0 when the interface does not exist
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadInterfaceCounter
+(
+    const char* interfaceNamePtr,   ///< [IN] Network interface name
+    const char* counterPtr          ///< [IN] Counter path, relative to the interface directory
+)
+{
+    char               path[PATH_MAX];
+    FILE*              filePtr;
+    unsigned long long value = 0;
+
+    snprintf(path, sizeof(path), "%s/%s/%s", SYSFS_NET_PATH, interfaceNamePtr, counterPtr);
+
+    filePtr = fopen(path, "r");
+    if (NULL == filePtr)
+    {
+        return 0;
+    }
+
+    if (fscanf(filePtr, "%llu", &value) != 1)
+    {
+        LE_WARN("Failed to read %s", path);
+        value = 0;
+    }
+    fclose(filePtr);
+
+    return (uint64_t)value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the increment of a kernel counter since its last sample. A counter lower than its last
+ * sample means that the interface has been created again.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t CounterIncrement
+(
+    uint64_t newValue,      ///< [IN] New counter value
+    uint64_t lastValue      ///< [IN] Last sample of the counter
+)
+{
+    return (newValue >= lastValue) ? (newValue - lastValue) : newValue;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Accumulate the increments of a new sample of the counters of a PPP session.
  */
 //--------------------------------------------------------------------------------------------------
+static void AccumulateDataFlowSample
+(
+    DataSession_t*                sessionPtr,   ///< [IN] The data session
+    const pa_mdc_PktStatistics_t* samplePtr     ///< [IN] New sample of the session counters
+)
+{
+    uint64_t rxIncrement = CounterIncrement(samplePtr->receivedBytesCount,
+                                            sessionPtr->lastSample.receivedBytesCount);
+    uint64_t txIncrement = CounterIncrement(samplePtr->transmittedBytesCount,
+                                            sessionPtr->lastSample.transmittedBytesCount);
+
+    DataFlowCounters.totalCount.receivedBytesCount += rxIncrement;
+    DataFlowCounters.totalCount.transmittedBytesCount += txIncrement;
 
-static le_event_Id_t CallEventId;
+    if (DataFlowCounters.isCollecting)
+    {
+        DataFlowCounters.statisticsCount.receivedBytesCount += rxIncrement;
+        DataFlowCounters.statisticsCount.transmittedBytesCount += txIncrement;
+    }
+
+    sessionPtr->lastSample = *samplePtr;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Define an invalid profile index. Since profile indices start at 1, 0 is an invalid index.
+ * Sample the kernel counters of the PPP interfaces and accumulate their increments.
  */
 //--------------------------------------------------------------------------------------------------
-#define INVALID_PROFILE_INDEX       0
+static void SampleDataFlowCounters
+(
+    void
+)
+{
+    pa_mdc_PktStatistics_t sample;
+    uint32_t               profileIndex;
+
+    for (profileIndex = 1; profileIndex <= PA_MDC_MAX_PROFILE; profileIndex++)
+    {
+        DataSession_t* sessionPtr = &DataSessions[profileIndex];
+
+        if (NULL_CHAR == sessionPtr->interfaceName[0])
+        {
+            continue;
+        }
+
+        sample.receivedBytesCount = ReadInterfaceCounter(sessionPtr->interfaceName,
+                                                         SYSFS_RX_BYTES);
+        sample.transmittedBytesCount = ReadInterfaceCounter(sessionPtr->interfaceName,
+                                                            SYSFS_TX_BYTES);
+
+        if ((0 == sample.receivedBytesCount) && (0 == sample.transmittedBytesCount))
+        {
+            // The interface is already removed: keep the last sample
+            continue;
+        }
+
+        AccumulateDataFlowSample(sessionPtr, &sample);
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Define a static pool for session state.
+ * Release the resources of a PPP session once pppd has terminated.
  */
 //--------------------------------------------------------------------------------------------------
-LE_MEM_DEFINE_STATIC_POOL(SessionStatePool, 1, sizeof(pa_mdc_SessionStateData_t));
+static void CleanPPPSession
+(
+    DataSession_t* sessionPtr    ///< [IN] The data session
+)
+{
+    if (sessionPtr->logMonitorRef)
+    {
+        le_fdMonitor_Delete(sessionPtr->logMonitorRef);
+        sessionPtr->logMonitorRef = NULL;
+    }
+
+    if (sessionPtr->logFd >= 0)
+    {
+        close(sessionPtr->logFd);
+        sessionPtr->logFd = -1;
+    }
+
+    le_timer_Stop(sessionPtr->timerRef);
+
+    sessionPtr->pid = 0;
+    sessionPtr->logLineLen = 0;
+    sessionPtr->interfaceName[0] = NULL_CHAR;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This event is reported when a data session state change is received from the modem.  The
- * report data is allocated from the associated pool.   Only one event handler is allowed to be
- * registered at a time, so its reference is stored, in case it needs to be removed later.
+ * Process a pppd log line to follow the negotiation progress.
  */
 //--------------------------------------------------------------------------------------------------
-static le_event_Id_t         SessionStateEventId;
-static le_mem_PoolRef_t      SessionStatePool;
-static le_event_HandlerRef_t NewSessionStateHandlerRef = NULL;
+static void ProcessPppLogLine
+(
+    DataSession_t* sessionPtr,  ///< [IN] The data session
+    const char*    linePtr      ///< [IN] pppd log line
+)
+{
+    static const char      usingInterfaceStr[] = "Using interface ";
+    const char*            interfacePtr;
+    unsigned long long     txBytes;
+    unsigned long long     rxBytes;
+    pa_mdc_PktStatistics_t sample;
+
+    LE_DEBUG("pppd %d: %s", (int)sessionPtr->pid, linePtr);
+
+    if ((interfacePtr = strstr(linePtr, usingInterfaceStr)) != NULL)
+    {
+        // The interface is created: its counters start from zero
+        interfacePtr += sizeof(usingInterfaceStr) - 1;
+        if (le_utf8_Copy(sessionPtr->interfaceName,
+                         interfacePtr,
+                         sizeof(sessionPtr->interfaceName),
+                         NULL) != LE_OK)
+        {
+            LE_ERROR("Interface name '%s' is too long", interfacePtr);
+            sessionPtr->interfaceName[0] = NULL_CHAR;
+        }
+        memset(&sessionPtr->lastSample, 0, sizeof(sessionPtr->lastSample));
+    }
+    else if (FIND_STRING("local  IP address", linePtr))
+    {
+        // IPCP is up: the PPP session is established
+        le_timer_Stop(sessionPtr->timerRef);
+        SampleDataFlowCounters();
+        ReportSessionState(sessionPtr, LE_MDC_CONNECTED);
+    }
+    else if (sscanf(linePtr, "Sent %llu bytes, received %llu bytes", &txBytes, &rxBytes) == 2)
+    {
+        // Final statistics of the link, logged before the interface is removed: the counters of
+        // the interface cannot be sampled once pppd has terminated
+        sample = sessionPtr->lastSample;
+        if ((uint64_t)rxBytes > sample.receivedBytesCount)
+        {
+            sample.receivedBytesCount = rxBytes;
+        }
+        if ((uint64_t)txBytes > sample.transmittedBytesCount)
+        {
+            sample.transmittedBytesCount = txBytes;
+        }
+        AccumulateDataFlowSample(sessionPtr, &sample);
+    }
+    else if (FIND_STRING("Connect:", linePtr))
+    {
+        // The serial link is up: LCP and authentication are in progress
+        ReportSessionState(sessionPtr, LE_MDC_AUTHENTICATING);
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * The modem currently only supports one data session at a time, but the API provides support for
- * more. Therefore, the profile index of the current data session needs to be stored.  This
- * would normally be set when the data session is started, and cleared when it is stopped.  This
- * profile could be either connected or disconnected; all other profiles are always disconnected.
+ * Read and process the pending lines of a pppd log pipe.
  */
 //--------------------------------------------------------------------------------------------------
-static uint32_t CurrentDataSessionIndex=INVALID_PROFILE_INDEX;
+static void ReadPppLog
+(
+    DataSession_t* sessionPtr   ///< [IN] The data session
+)
+{
+    char    readBuffer[PPP_LOG_LINE_MAX_BYTES];
+    ssize_t readLen;
+    ssize_t i;
+
+    while ((readLen = read(sessionPtr->logFd, readBuffer, sizeof(readBuffer))) > 0)
+    {
+        for (i = 0; i < readLen; i++)
+        {
+            if ('\n' == readBuffer[i])
+            {
+                sessionPtr->logLine[sessionPtr->logLineLen] = NULL_CHAR;
+                ProcessPppLogLine(sessionPtr, sessionPtr->logLine);
+                sessionPtr->logLineLen = 0;
+            }
+            else if (sessionPtr->logLineLen < sizeof(sessionPtr->logLine) - 1)
+            {
+                sessionPtr->logLine[sessionPtr->logLineLen++] = readBuffer[i];
+            }
+        }
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Unsolicited references
+ * Handler of a pppd log pipe.
  */
 //--------------------------------------------------------------------------------------------------
-static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCgevRef = NULL;
+static void PppLogHandler
+(
+    int   fd,       ///< [IN] Read end of the pppd log pipe
+    short events    ///< [IN] Poll events
+)
+{
+    DataSession_t* sessionPtr = le_fdMonitor_GetContextPtr();
+
+    if (events & POLLIN)
+    {
+        ReadPppLog(sessionPtr);
+    }
 
+    if ((events & (POLLHUP | POLLERR)) && (sessionPtr->logMonitorRef))
+    {
+        // pppd closed its log: stop monitoring, the SIGCHLD handler completes the clean-up
+        le_fdMonitor_Delete(sessionPtr->logMonitorRef);
+        sessionPtr->logMonitorRef = NULL;
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Mutex used to protect access to CurrentDataSessionIndex.
+ * SIGCHLD handler: reap the terminated pppd processes and report the end of their sessions.
  */
 //--------------------------------------------------------------------------------------------------
-static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // POSIX "Fast" mutex.
+static void PppChildHandler
+(
+    int sigNum      ///< [IN] Signal number
+)
+{
+    uint32_t profileIndex;
+    int      statchild;
 
-/// Locks the mutex.
-#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0)
+    for (profileIndex = 1; profileIndex <= PA_MDC_MAX_PROFILE; profileIndex++)
+    {
+        DataSession_t* sessionPtr = &DataSessions[profileIndex];
 
-/// Unlocks the mutex.
-#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0)
+        if ((0 == sessionPtr->pid) ||
+            (waitpid(sessionPtr->pid, &statchild, WNOHANG) != sessionPtr->pid))
+        {
+            continue;
+        }
+
+        if (WIFEXITED(statchild))
+        {
+            LE_INFO("pppd of profile %"PRIu32" exited with code %d",
+                    profileIndex, WEXITSTATUS(statchild));
+        }
+        else
+        {
+            LE_WARN("pppd of profile %"PRIu32" did not terminate with exit", profileIndex);
+        }
+
+        // Process the last log lines of pppd, they hold the final statistics of the link, and
+        // take the last sample of the counters before the interface name is released
+        if (sessionPtr->logFd >= 0)
+        {
+            ReadPppLog(sessionPtr);
+        }
+        SampleDataFlowCounters();
+
+        CleanPPPSession(sessionPtr);
+        ReportSessionState(sessionPtr, LE_MDC_DISCONNECTED);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Negotiation timer handler: pppd did not establish the session in time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PppTimeoutHandler
+(
+    le_timer_Ref_t timerRef     ///< [IN] Negotiation timer
+)
+{
+    DataSession_t* sessionPtr = le_timer_GetContextPtr(timerRef);
 
+    if (sessionPtr->pid)
+    {
+        LE_WARN("PPP negotiation timeout, terminate pppd %d", (int)sessionPtr->pid);
+        kill(sessionPtr->pid, SIGTERM);
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the current data session index, ensuring that access is protected by a mutex
+ * Start the ppp interface of a data session. pppd is started in the background on the PPP port
+ * of the session, the session state is reported once the negotiation is over.
  *
- * @return
- *      The index value
+ * @return LE_OK            pppd is started
+ * @return LE_DUPLICATE     pppd is already running
+ * @return LE_FAULT         Failed to start pppd
  */
 //--------------------------------------------------------------------------------------------------
-static inline uint32_t GetCurrentDataSessionIndex(void)
+static le_result_t StartPPPInterface
+(
+    DataSession_t* sessionPtr    ///< [IN] The data session
+)
 {
-    uint32_t index;
+    char*    pppPathPtr = pa_utils_GetPppPathByIndex(sessionPtr->portIndex);
+    uint32_t defaultProfileIndex;
+    bool     isDefaultProfile;
+    int      pipeFd[2];
+    pid_t    pid;
 
-    LOCK;
-    index = CurrentDataSessionIndex;
-    UNLOCK;
+    if (sessionPtr->pid)
+    {
+        LE_ERROR("pppd is already running for profile %"PRIu32, sessionPtr->profileIndex);
+        return LE_DUPLICATE;
+    }
 
-    return index;
-}
+    if (NULL == pppPathPtr)
+    {
+        LE_ERROR("No path for PPP port %"PRIu32, sessionPtr->portIndex);
+        return LE_FAULT;
+    }
+
+    isDefaultProfile = ((LE_OK == pa_mdc_GetDefaultProfileIndex(&defaultProfileIndex)) &&
+                        (defaultProfileIndex == sessionPtr->profileIndex));
+
+    if (pipe(pipeFd) == -1)
+    {
+        LE_ERROR("Failed to create the pppd log pipe, errno %d", errno);
+        return LE_FAULT;
+    }
+
+    pid = fork();
+    if (pid == -1)
+    {
+        close(pipeFd[0]);
+        close(pipeFd[1]);
+        return LE_FAULT;
+    }
+    else if ( pid == 0) // child process
+    {
+        char* args[] = {
+            "pppd",     /* argv[0], programme name. */
+            "noauth",
+            "nolock",
+            "debug",
+            pppPathPtr,
+            "115200",
+            "noipdefault",
+            "dump",
+            "noccp",
+            "usepeerdns",
+            "nodetach",
+            "ipcp-accept-local",
+            "ipcp-accept-remote",
+            "0.0.0.0:0.0.0.0",
+            "novj",
+            "nomagic",
+            "noaccomp",
+            "nopcomp",
+            NULL,     /* Reserved for the default route options. */
+            NULL,
+            NULL      /* list of argument must finished by NULL.  */
+        };
+
+        // Only the session of the default profile may own the default route, the other sessions
+        // must not replace it
+        if (isDefaultProfile)
+        {
+            args[NUM_ARRAY_MEMBERS(args) - 3] = "defaultroute";
+            args[NUM_ARRAY_MEMBERS(args) - 2] = "replacedefaultroute";
+        }
+
+        // pppd logs on its standard output when it runs in the foreground
+        close(pipeFd[0]);
+        dup2(pipeFd[1], STDOUT_FILENO);
+        close(pipeFd[1]);
+
+        execvp("/usr/sbin/pppd", args);
+
+        LE_INFO("Please install PPP daemon ($ sudo apt-get install ppp)");
+        _exit(EXIT_FAILURE);
+    }
+
+    close(pipeFd[1]);
+    fcntl(pipeFd[0], F_SETFL, fcntl(pipeFd[0], F_GETFL) | O_NONBLOCK);
+
+    LE_INFO("PPP daemon launched on %s for profile %"PRIu32", pid %d",
+            pppPathPtr, sessionPtr->profileIndex, (int)pid);
 
+    if (NULL == sessionPtr->timerRef)
+    {
+        sessionPtr->timerRef = le_timer_Create("PppNegotiationTimer");
+        le_timer_SetMsInterval(sessionPtr->timerRef, PPP_NEGOTIATION_TIMEOUT);
+        le_timer_SetHandler(sessionPtr->timerRef, PppTimeoutHandler);
+        le_timer_SetContextPtr(sessionPtr->timerRef, sessionPtr);
+    }
+
+    sessionPtr->pid = pid;
+    sessionPtr->logFd = pipeFd[0];
+    sessionPtr->logLineLen = 0;
+    sessionPtr->interfaceName[0] = NULL_CHAR;
+    sessionPtr->logMonitorRef = le_fdMonitor_Create("PppLog", pipeFd[0], PppLogHandler, POLLIN);
+    le_fdMonitor_SetContextPtr(sessionPtr->logMonitorRef, sessionPtr);
+    le_timer_Start(sessionPtr->timerRef);
+
+    return LE_OK;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Set the current data session index, ensuring that access is protected by a mutex
+ * Stop the ppp interface of a data session. The end of the session is reported when pppd has
+ * terminated.
  */
 //--------------------------------------------------------------------------------------------------
-static inline void SetCurrentDataSessionIndex(uint32_t index)
+static void StopPPPInterface
+(
+    DataSession_t* sessionPtr    ///< [IN] The data session
+)
 {
-    LOCK;
-    CurrentDataSessionIndex = index;
-    UNLOCK;
+    if (sessionPtr->pid)
+    {
+        // Account for the data exchanged before the interface disappears
+        SampleDataFlowCounters();
+
+        LE_DEBUG("Terminate pppd %d", (int)sessionPtr->pid);
+        kill(sessionPtr->pid, SIGTERM);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -171,6 +1037,126 @@ static le_result_t ActivateContext
     return res;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Effect of a +CGEV event on the data sessions
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    CGEV_PDN_ACT,       ///< PDN connection activated: <cid>
+    CGEV_PDN_DEACT,     ///< PDN connection deactivated: <cid>
+    CGEV_ACT,           ///< Context activated: <PDP_type>,<PDP_addr>[,<cid>] or <p_cid>,<cid>,...
+    CGEV_DEACT,         ///< Context deactivated: <PDP_type>,<PDP_addr>[,<cid>] or <p_cid>,<cid>,...
+    CGEV_MODIFY,        ///< Context modified: <cid>,<change_reason>,<event_type>
+    CGEV_DETACH,        ///< Packet domain detach: all the contexts are deactivated
+    CGEV_INFO           ///< No effect on the data sessions
+}
+CgevAction_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * +CGEV event, from 3GPP 27.007 (including the Rel-10 formats)
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*  eventStr;      ///< Event name
+    CgevAction_t action;        ///< Effect of the event
+}
+CgevEvent_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Known +CGEV events. An event name must be listed before the names it starts with.
+ */
+//--------------------------------------------------------------------------------------------------
+static const CgevEvent_t CgevEvents[] =
+{
+    { "NW PDN ACT",     CGEV_PDN_ACT   },
+    { "ME PDN ACT",     CGEV_PDN_ACT   },
+    { "PDN ACT",        CGEV_PDN_ACT   },
+    { "NW PDN DEACT",   CGEV_PDN_DEACT },
+    { "ME PDN DEACT",   CGEV_PDN_DEACT },
+    { "PDN DEACT",      CGEV_PDN_DEACT },
+    { "NW ACT",         CGEV_ACT       },
+    { "ME ACT",         CGEV_ACT       },
+    { "NW REACT",       CGEV_ACT       },
+    { "NW DEACT",       CGEV_DEACT     },
+    { "ME DEACT",       CGEV_DEACT     },
+    { "NW MODIFY",      CGEV_MODIFY    },
+    { "ME MODIFY",      CGEV_MODIFY    },
+    { "NW DETACH",      CGEV_DETACH    },
+    { "ME DETACH",      CGEV_DETACH    },
+    { "NW CLASS",       CGEV_INFO      },
+    { "ME CLASS",       CGEV_INFO      },
+    { "REJECT",         CGEV_INFO      },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the context identifier of a +CGEV event from its arguments
+ *
+ * @return
+ *      The cid, 0 if the event does not give it
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetCgevCid
+(
+    CgevAction_t action,        ///< [IN] Effect of the event
+    char*        argsPtr,       ///< [IN] Isolated arguments of the event
+    uint32_t     numArgs        ///< [IN] Number of arguments
+)
+{
+    if (0 == numArgs)
+    {
+        return 0;
+    }
+
+    switch (action)
+    {
+        case CGEV_PDN_ACT:
+        case CGEV_PDN_DEACT:
+        case CGEV_MODIFY:
+            return atoi(pa_utils_IsolateLineParameter(argsPtr, 1));
+
+        case CGEV_ACT:
+        case CGEV_DEACT:
+            // Rel-10 format starts with the numeric <p_cid>, legacy format with the <PDP_type>
+            if (isdigit((unsigned char)argsPtr[0]))
+            {
+                return (numArgs >= 2) ? atoi(pa_utils_IsolateLineParameter(argsPtr, 2)) : 0;
+            }
+
+            return (numArgs >= 3) ? atoi(pa_utils_IsolateLineParameter(argsPtr, 3)) : 0;
+
+        default:
+            return 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Terminate a data session on network or modem request
+ */
+//--------------------------------------------------------------------------------------------------
+static void DisconnectSession
+(
+    DataSession_t* sessionPtr   ///< [IN] The data session
+)
+{
+    if ((LE_MDC_DISCONNECTED == GetDataSessionState(sessionPtr)) && (0 == sessionPtr->pid))
+    {
+        return;
+    }
+
+    LE_INFO("Data session of profile %"PRIu32" is deactivated", sessionPtr->profileIndex);
+
+    // Only the PPP session of this context is terminated
+    StopPPPInterface(sessionPtr);
+    ReportSessionState(sessionPtr, LE_MDC_DISCONNECTED);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The handler for GPRS Event Notification.
@@ -183,37 +1169,96 @@ static void CGEVUnsolHandler
     void* contextPtr
 )
 {
-    uint32_t                   numParam        = 0;
-    pa_mdc_SessionStateData_t* sessionStatePtr = NULL;
+    char                 lineStr[LE_ATDEFS_UNSOLICITED_MAX_BYTES];
+    char*                eventPtr;
+    char*                argsPtr;
+    const CgevEvent_t*   cgevPtr = NULL;
+    uint32_t             numArgs = 0;
+    uint32_t             cid;
+    uint32_t             i;
+    size_t               len;
+
+    // Any PDP context event may change the dynamic parameters of the contexts
+    pa_mdc_utils_InvalidateIpParam(0);
+
+    le_utf8_Copy(lineStr, unsolPtr, sizeof(lineStr), NULL);
+
+    eventPtr = lineStr + strlen("+CGEV:");
+    while (' ' == *eventPtr)
+    {
+        eventPtr++;
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(CgevEvents); i++)
+    {
+        len = strlen(CgevEvents[i].eventStr);
+        if ((0 == strncmp(eventPtr, CgevEvents[i].eventStr, len)) &&
+            ((' ' == eventPtr[len]) || (NULL_CHAR == eventPtr[len])))
+        {
+            cgevPtr = &CgevEvents[i];
+            break;
+        }
+    }
 
-    if ( ( FIND_STRING("+CGEV: NW DEACT", unsolPtr) )
-        ||
-         ( FIND_STRING("+CGEV: ME DEACT", unsolPtr) )
-       )
+    if (NULL == cgevPtr)
     {
-        numParam = pa_utils_CountAndIsolateLineParameters((char*)unsolPtr);
+        LE_WARN("this Response pattern is not expected -%s-",unsolPtr);
+        return;
+    }
 
-        if (numParam == 4)
-        {
-            sessionStatePtr = le_mem_ForceAlloc(SessionStatePool);
-            sessionStatePtr->profileIndex = atoi(pa_utils_IsolateLineParameter(unsolPtr,4));
-            sessionStatePtr->newState = LE_MDC_DISCONNECTED;
+    argsPtr = eventPtr + len;
+    while (' ' == *argsPtr)
+    {
+        argsPtr++;
+    }
+    if (NULL_CHAR != *argsPtr)
+    {
+        numArgs = pa_utils_CountAndIsolateLineParametersWithChar(argsPtr, COMMA_CHAR);
+    }
 
-            SetCurrentDataSessionIndex(INVALID_PROFILE_INDEX);
+    cid = GetCgevCid(cgevPtr->action, argsPtr, numArgs);
 
-            LE_DEBUG("Send Event for %" PRIu32 " with state %d",
-                     sessionStatePtr->profileIndex,
-                     sessionStatePtr->newState);
-            le_event_ReportWithRefCounting(SessionStateEventId,sessionStatePtr);
-        }
-        else
+    LE_DEBUG("+CGEV %s, cid %"PRIu32, cgevPtr->eventStr, cid);
+
+    switch (cgevPtr->action)
+    {
+        case CGEV_PDN_DEACT:
+        case CGEV_DEACT:
         {
-            LE_WARN("this Response pattern is not expected -%s-",unsolPtr);
+            DataSession_t* sessionPtr = GetDataSession(pa_mdc_local_GetProfileIndexFromCid(cid));
+
+            if (sessionPtr)
+            {
+                DisconnectSession(sessionPtr);
+            }
+            else
+            {
+                LE_WARN("No data session for the deactivated cid %"PRIu32, cid);
+            }
+            break;
         }
+
+        case CGEV_DETACH:
+            // All the contexts are deactivated by the detach
+            for (i = 1; i <= PA_MDC_MAX_PROFILE; i++)
+            {
+                DisconnectSession(&DataSessions[i]);
+            }
+            break;
+
+        case CGEV_PDN_ACT:
+        case CGEV_ACT:
+        case CGEV_MODIFY:
+            // The session state is driven by the PPP negotiation, only the dynamic parameters
+            // of the context have changed
+            break;
+
+        case CGEV_INFO:
+        default:
+            break;
     }
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Enable or disable GPRS Event reporting.
@@ -274,7 +1319,8 @@ static le_result_t SetIndicationHandler
 //--------------------------------------------------------------------------------------------------
 static le_result_t StartPDPConnection
 (
-    uint32_t profileIndex    ///< [IN] The profile identifier
+    uint32_t profileIndex,   ///< [IN] The profile identifier
+    uint32_t portIndex       ///< [IN] The PPP port to use
 )
 {
     le_atClient_CmdRef_t cmdRef = NULL;
@@ -309,7 +1355,7 @@ static le_result_t StartPDPConnection
         LE_ERROR("Failed to set final response !");
         return res;
     }
-    res = le_atClient_SetDevice(cmdRef, pa_utils_GetPppDeviceRef());
+    res = le_atClient_SetDevice(cmdRef, pa_utils_GetPppDeviceRefByIndex(portIndex));
     if (res != LE_OK)
     {
         le_atClient_Delete(cmdRef);
@@ -349,141 +1395,125 @@ static le_result_t StartPDPConnection
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Hang up the PDP Modem connection.
+ * Establish the connection.
+ *  - ask the PDP connection to start on Modem
+ *  - start a PPP connection to link with the Modem PPP Server
  *
- * @return LE_OK            Activate the profile in the modem
- * @return LE_FAULT         Could not hang up the PDP connection
- * @return LE_TIMEOUT       Command failed with timeout
+ * @return LE_OK            The connection is in progress, its state is reported by event
+ * @return LE_FAULT         could not establish connection for the profile
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t StopPDPConnection
+static le_result_t EstablishConnection
 (
+    DataSession_t* sessionPtr    ///< [IN] The data session
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_FAULT;
+    // Start the PDP connection on Modem side
+    if (StartPDPConnection(sessionPtr->profileIndex, sessionPtr->portIndex) != LE_OK)
+    {
+        return LE_FAULT;
+    }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "ATGH",
-                                        DEFAULT_EMPTY_INTERMEDIATE,
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
+    // Start the PPP connection on application side
+    if (StartPPPInterface(sessionPtr) != LE_OK)
+    {
+        return LE_FAULT;
+    }
 
-    le_atClient_Delete(cmdRef);
-    return res;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Start the ppp interface.
+ * This function must be called to initialize the mdc module
  *
- * @return LE_OK            Activate the ppp interface with linux
- * @return LE_FAULT         Failed to activate the ppp interface with linux
+ * @return LE_FAULT         The function failed to initialize the module.
+ * @return LE_OK            The function succeeded.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t StartPPPInterface
+le_result_t pa_mdc_Init
 (
     void
 )
 {
-    pid_t pid = fork();
-    if (pid == -1)
+    SessionStateEventId = le_event_CreateIdWithRefCounting("SessionStateEventId");
+    SessionStatePool = le_mem_InitStaticPool(SessionStatePool,
+                                             SESSION_STATE_POOL_SIZE,
+                                             sizeof(pa_mdc_SessionStateData_t));
+
+    for (uint32_t i = 0; i <= PA_MDC_MAX_PROFILE; i++)
     {
-        return LE_FAULT;
+        memset(&DataSessions[i], 0, sizeof(DataSession_t));
+        DataSessions[i].profileIndex = i;
+        DataSessions[i].state = LE_MDC_DISCONNECTED;
+        DataSessions[i].logFd = -1;
+        DataSessions[i].reconnectTimerRef = le_timer_Create("MdcReconnectTimer");
+        le_timer_SetHandler(DataSessions[i].reconnectTimerRef, ReconnectTimerHandler);
+        le_timer_SetContextPtr(DataSessions[i].reconnectTimerRef, &DataSessions[i]);
     }
-    else if ( pid == 0) // child process
-    {
-        char* args[] = {
-            "pppd",     /* argv[0], programme name. */
-            "noauth",
-            "nolock",
-            "debug",
-            pa_utils_GetPppPath(),
-            "115200",
-            "defaultroute",
-            "noipdefault",
-            "replacedefaultroute",
-            "dump",
-            "noccp",
-            "usepeerdns",
-            "updetach",
-            "ipcp-accept-local",
-            "ipcp-accept-remote",
-            "0.0.0.0:0.0.0.0",
-            "novj",
-            "nomagic",
-            "noaccomp",
-            "nopcomp",
-            NULL      /* list of argument must finished by NULL.  */
-        };
 
-        if (execvp("/usr/sbin/pppd", args) < 0)
-        {
-            LE_INFO("Please install PPP daemon ($ sudo apt-get install ppp)");
-            return LE_FAULT;
-        }
-        else
-        {
-            LE_INFO("PPP daemon launched");
-            return 99;
-        }
-    }
-    else
-    {
-        int statchild;
-        wait(&statchild); // wait for child to finished
+    // pppd termination is caught on the event loop
+    le_sig_Block(SIGCHLD);
+    le_sig_SetEventHandler(SIGCHLD, PppChildHandler);
 
-        if (WIFEXITED(statchild))
-        {
-            LE_DEBUG("Child's exit code %d\n", WEXITSTATUS(statchild));
+    // set unsolicited +CGEV to Register our own handler.
+    SetIndicationHandler(2);
 
-            if (WEXITSTATUS(statchild) == 0)
-            {
-                // Remove the NO CARRIER unsolicited
-                //~le_atClient_RemoveUnsolicitedResponseHandler(CallEventId,"NO CARRIER");
+    for(int i=1; i<= PA_MDC_MAX_PROFILE; i++)
+    {
+        pa_mdc_local_SetCidFromProfileIndex(i,i);
+    }
 
-                return LE_OK;
-            }
-            else
-            {
-                return LE_FAULT;
-            }
-        }
-        else
-        {
-            LE_WARN("Child did not terminate with exit\n");
-            return LE_FAULT;
-        }
+    return LE_OK;
+}
 
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called from each thread to connect PA MDC services.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_mdc_AsyncInit
+(
+    void
+)
+{
+    le_atClient_TryConnectService();
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Establish the connection.
- *  - ask the PDP connection to start on Modem
- *  - start a PPP connection to link with the Modem PPP Server
+ * Set the reconnection policy of the data sessions dropped by the network
  *
- * @return LE_OK            The connection is established
- * @return LE_FAULT         could not establish connection for the profile
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The policy is invalid.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t EstablishConnection
+le_result_t pa_mdc_SetReconnectPolicy
 (
-    uint32_t profileIndex    ///< [IN] The profile identifier
+    const pa_mdc_ReconnectPolicy_t* policyPtr   ///< [IN] The reconnection policy
 )
 {
-    // Start the PDP connection on Modem side
-    if (StartPDPConnection(profileIndex) != LE_OK)
+    uint32_t i;
+
+    if ((NULL == policyPtr) ||
+        ((policyPtr->isEnabled) &&
+         ((0 == policyPtr->initialDelayMs) || (policyPtr->maxDelayMs < policyPtr->initialDelayMs))))
     {
-        return LE_FAULT;
+        LE_ERROR("Invalid reconnection policy");
+        return LE_BAD_PARAMETER;
     }
 
-    // Start the PPP connection on application side
-    if (StartPPPInterface() != LE_OK)
+    ReconnectPolicy = *policyPtr;
+
+    if (!ReconnectPolicy.isEnabled)
     {
-        return LE_FAULT;
+        // Cancel the pending reconnections
+        for (i = 1; i <= PA_MDC_MAX_PROFILE; i++)
+        {
+            DataSessions[i].isReconnecting = false;
+            le_timer_Stop(DataSessions[i].reconnectTimerRef);
+        }
     }
 
     return LE_OK;
@@ -491,169 +1521,245 @@ static le_result_t EstablishConnection
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to register a handler for a ppp call.
+ * Set the APN used to create a profile which does not exist on the modem
  *
+ * @return LE_OK            The function succeeded.
+ * @return LE_OVERFLOW      The APN is too long.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_SetDefaultApn
+(
+    const char* apnPtr          ///< [IN] The default APN, empty for none
+)
+{
+    return le_utf8_Copy(DefaultApn, apnPtr ? apnPtr : "", sizeof(DefaultApn), NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the reconnection counters of a data session
  *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
  */
 //--------------------------------------------------------------------------------------------------
-static void PppCallHandler
+le_result_t pa_mdc_GetReconnectCounters
 (
-    void* reportPtr
+    uint32_t                    profileIndex,   ///< [IN]  The profile to use
+    pa_mdc_ReconnectCounters_t* countersPtr     ///< [OUT] The reconnection counters
 )
 {
-    char* unsolPtr = reportPtr;
+    DataSession_t* sessionPtr = GetDataSession(profileIndex);
 
-    if (FIND_STRING("NO CARRIER", unsolPtr))
+    if ((NULL == sessionPtr) || (NULL == countersPtr))
     {
-        SetCurrentDataSessionIndex(INVALID_PROFILE_INDEX);
-        //~le_atClient_RemoveUnsolicitedResponseHandler(CallEventId,"NO CARRIER");
+        return LE_BAD_PARAMETER;
     }
+
+    *countersPtr = sessionPtr->reconnectCounters;
+
+    return LE_OK;
 }
 
+
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to initialize the mdc module
+ * Get the index (CID) of the default profile (link to the platform)
  *
- * @return LE_FAULT         The function failed to initialize the module.
- * @return LE_OK            The function succeeded.
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ *      - LE_BAD_PARAMETER on a null profileIndexPtr
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_mdc_Init
+le_result_t pa_mdc_GetDefaultProfileIndex
 (
-    void
+    uint32_t* profileIndexPtr
 )
 {
-    SessionStateEventId = le_event_CreateIdWithRefCounting("SessionStateEventId");
-    SessionStatePool = le_mem_InitStaticPool(SessionStatePool,
-                                             1,
-                                             sizeof(pa_mdc_SessionStateData_t));
-    CallEventId = le_event_CreateId("CallEventId",LE_ATDEFS_RESPONSE_MAX_BYTES);
-    le_event_AddHandler("PppCallHandler",CallEventId,PppCallHandler);
-
-    // set unsolicited +CGEV to Register our own handler.
-    SetIndicationHandler(2);
-
-    for(int i=1; i<= PA_MDC_MAX_PROFILE; i++)
+    if (NULL == profileIndexPtr)
     {
-        pa_mdc_local_SetCidFromProfileIndex(i,i);
+        LE_ERROR("profileIndexPtr is NULL");
+        return LE_BAD_PARAMETER;
     }
 
+    *profileIndexPtr = 1;
     return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called from each thread to connect PA MDC services.
+ * Read the profile data for the given profile
  *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER when profileIndex is 0 or profileDataPtr is NULL
+ *      - LE_FAULT on failure
  */
 //--------------------------------------------------------------------------------------------------
-void pa_mdc_AsyncInit
+le_result_t pa_mdc_ReadProfile
 (
-    void
+    uint32_t              profileIndex,     ///< [IN] The profile to read
+    pa_mdc_ProfileData_t* profileDataPtr    ///< [OUT] The profile data
 )
 {
-    le_atClient_TryConnectService();
+    le_result_t res = LE_FAULT;
+
+    if(!profileDataPtr)
+    {
+        LE_DEBUG("Invalid profileDataPtr");
+        return LE_BAD_PARAMETER;
+    }
+    if (!profileIndex)
+    {
+        LE_DEBUG("Invalid profileIndex");
+        return LE_BAD_PARAMETER;
+    }
+
+    res = pa_mdc_utils_GetCachedProfile(profileIndex, profileDataPtr);
+    if (LE_NOT_FOUND == res)
+    {
+        LE_DEBUG("Profile %"PRIu32" is not defined", profileIndex);
+        res = LE_FAULT;
+    }
+
+    return res;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the profile already exists on the modem ; if not, ask to the modem to create a new
+ * profile.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER on parameters invalid.
+ *      - LE_TIMEOUT on no response received.
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_InitializeProfile
+(
+    uint32_t profileIndex     ///< [IN] The profile to write
+)
+{
+    pa_mdc_ProfileData_t profileData;
+    le_result_t          res          = LE_FAULT;
+
+    res = pa_mdc_ReadProfile(profileIndex, &profileData);
+
+    if (res != LE_OK)
+    {
+        if (NULL_CHAR == DefaultApn[0])
+        {
+            LE_WARN("No default APN to initialize profile %"PRIu32, profileIndex);
+            return res;
+        }
+
+        memset(&profileData,0,sizeof(pa_mdc_ProfileData_t));
+        le_utf8_Copy(profileData.apn, DefaultApn, sizeof(profileData.apn), NULL);
+        profileData.pdp = LE_MDC_PDP_IPV4;
+        LE_INFO("Initialize");
+        res = pa_mdc_WriteProfile(profileIndex, &profileData);
+    }
+
+    return res;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the index (CID) of the default profile (link to the platform)
+ * Send a command and check its final response.
  *
  * @return
  *      - LE_OK on success
+ *      - LE_TIMEOUT on no response received.
  *      - LE_FAULT on failure
- *      - LE_BAD_PARAMETER on a null profileIndexPtr
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_mdc_GetDefaultProfileIndex
+static le_result_t SendCommand
 (
-    uint32_t* profileIndexPtr
+    const char* commandStr      ///< [IN] The command to send
 )
 {
-    if (NULL == profileIndexPtr)
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res;
+    char                 responseStr[PA_AT_LOCAL_SHORT_SIZE] = {0};
+
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        commandStr,
+                                        DEFAULT_EMPTY_INTERMEDIATE,
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
+    {
+        return res;
+    }
+
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    le_atClient_Delete(cmdRef);
+
+    if ((res != LE_OK) || (strcmp(responseStr, "OK") != 0))
     {
-        LE_ERROR("profileIndexPtr is NULL");
-        return LE_BAD_PARAMETER;
+        LE_ERROR("%s failed: %s", commandStr, responseStr);
+        return LE_FAULT;
     }
 
-    *profileIndexPtr = 1;
     return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read the profile data for the given profile
+ * Get the PDP type string of AT+CGDCONT
  *
- * @return
- *      - LE_OK on success
- *      - LE_BAD_PARAMETER when profileIndex is 0 or profileDataPtr is NULL
- *      - LE_FAULT on failure
+ * @return The PDP type string
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_mdc_ReadProfile
+static const char* PdpTypeToString
 (
-    uint32_t              profileIndex,     ///< [IN] The profile to read
-    pa_mdc_ProfileData_t* profileDataPtr    ///< [OUT] The profile data
+    le_mdc_Pdp_t pdp            ///< [IN] The PDP type
 )
 {
-    le_result_t res = LE_FAULT;
-
-    if(!profileDataPtr)
-    {
-        LE_DEBUG("Invalid profileDataPtr");
-        return LE_BAD_PARAMETER;
-    }
-    if (!profileIndex)
+    switch (pdp)
     {
-        LE_DEBUG("Invalid profileIndex");
-        return LE_BAD_PARAMETER;
+        case LE_MDC_PDP_IPV6:
+            return "IPV6";
+        case LE_MDC_PDP_IPV4V6:
+            return "IPV4V6";
+        case LE_MDC_PDP_IPV4:
+        default:
+            return "IP";
     }
-
-    res = pa_mdc_GetAccessPointName(profileIndex, profileDataPtr->apn, PA_MDC_APN_MAX_BYTES);
-
-    profileDataPtr->pdp = LE_MDC_PDP_IPV4;
-    profileDataPtr->authentication.type = LE_MDC_AUTH_NONE;
-    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Check whether the profile already exists on the modem ; if not, ask to the modem to create a new
- * profile.
+ * Get the authentication protocol of AT+CGAUTH
  *
- * @return
- *      - LE_OK on success
- *      - LE_BAD_PARAMETER on parameters invalid.
- *      - LE_TIMEOUT on no response received.
- *      - LE_FAULT on failure
+ * @return The authentication protocol: 0 for none, 1 for PAP, 2 for CHAP
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_mdc_InitializeProfile
+static int AuthToProtocol
 (
-    uint32_t profileIndex     ///< [IN] The profile to write
+    le_mdc_Auth_t auth          ///< [IN] The authentication type
 )
 {
-    pa_mdc_ProfileData_t profileData;
-    le_result_t          res          = LE_FAULT;
-    char                 defaultAPN[] = "orange.fr";
-
-    res = pa_mdc_ReadProfile(profileIndex, &profileData);
-
-    if (res != LE_OK)
+    if (auth & LE_MDC_AUTH_CHAP)
     {
-        memset(&profileData,0,sizeof(pa_mdc_ProfileData_t));
-        strcpy(&profileData.apn[0],defaultAPN);
-        LE_INFO("Initialize");
-        res = pa_mdc_WriteProfile(profileIndex, &profileData);
+        return 2;
+    }
+    else if (auth & LE_MDC_AUTH_PAP)
+    {
+        return 1;
     }
 
-    return res;
+    return 0;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Write the profile data for the given profile
+ * Write the profile data for the given profile. The profile is compared with the context defined
+ * on the modem, and only the commands that change it are sent.
  *
  * @return
  *      - LE_OK on success
@@ -670,54 +1776,99 @@ le_result_t pa_mdc_WriteProfile
 {
     char                 commandStr[PA_AT_LOCAL_LONG_STRING_SIZE];
     le_result_t          res    = LE_FAULT;
-    le_atClient_CmdRef_t cmdRef = NULL;
+    pa_mdc_ProfileData_t currentData;
+    bool                 isDefined;
+    bool                 isWritten = false;
 
-    snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE,
-        "AT+CGQREQ=%"PRIu32",0,0,0,0,0",  profileIndex);
+    if ((!profileIndex) || (!profileDataPtr))
+    {
+        LE_DEBUG("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        commandStr,
-                                        DEFAULT_EMPTY_INTERMEDIATE,
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-    if (res == LE_OK)
+    memset(&currentData, 0, sizeof(currentData));
+    res = pa_mdc_utils_GetCachedProfile(profileIndex, &currentData);
+    isDefined = (LE_OK == res);
+    if ((!isDefined) && (LE_NOT_FOUND != res))
     {
-        le_atClient_Delete(cmdRef);
+        LE_WARN("Failed to read profile %"PRIu32", write it entirely", profileIndex);
+        memset(&currentData, 0, sizeof(currentData));
     }
 
-    snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE,
-             "AT+CGQMIN=%"PRIu32",0,0,0,0,0", profileIndex);
-    cmdRef = NULL;
-    res    = le_atClient_SetCommandAndSend(&cmdRef,
-                                           pa_utils_GetAtDeviceRef(),
-                                           commandStr,
-                                           DEFAULT_EMPTY_INTERMEDIATE,
-                                           DEFAULT_AT_RESPONSE,
-                                           DEFAULT_AT_CMD_TIMEOUT);
-    if (res == LE_OK)
+    // The QoS is only set to its subscribed value when the context is created
+    if (!isDefined)
     {
-        le_atClient_Delete(cmdRef);
+        snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE,
+                 "AT+CGQREQ=%"PRIu32",0,0,0,0,0", profileIndex);
+        if (SendCommand(commandStr) != LE_OK)
+        {
+            LE_WARN("Failed to set the requested QoS of profile %"PRIu32, profileIndex);
+        }
+
+        snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE,
+                 "AT+CGQMIN=%"PRIu32",0,0,0,0,0", profileIndex);
+        if (SendCommand(commandStr) != LE_OK)
+        {
+            LE_WARN("Failed to set the minimum QoS of profile %"PRIu32, profileIndex);
+        }
     }
 
+    if ((!isDefined) || (currentData.pdp != profileDataPtr->pdp) ||
+        (strcmp(currentData.apn, profileDataPtr->apn) != 0))
+    {
+        snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE,
+                 "AT+CGDCONT=%"PRIu32",\"%s\",\"%s\"",
+                 profileIndex, PdpTypeToString(profileDataPtr->pdp), profileDataPtr->apn);
+        res = SendCommand(commandStr);
+        isWritten = true;
+        if (res != LE_OK)
+        {
+            LE_ERROR("Write profile failed !");
+            pa_mdc_utils_InvalidateProfileCache();
+            return res;
+        }
+    }
 
-    snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE,
-             "AT+CGDCONT=%"PRIu32",\"%s\",\"%s\"", profileIndex, "IP", profileDataPtr->apn);
-    cmdRef = NULL;
-    res    = le_atClient_SetCommandAndSend(&cmdRef,
-                                           pa_utils_GetAtDeviceRef(),
-                                           commandStr,
-                                           DEFAULT_EMPTY_INTERMEDIATE,
-                                           DEFAULT_AT_RESPONSE,
-                                           DEFAULT_AT_CMD_TIMEOUT);
-    if (res != LE_OK)
+    if ((AuthToProtocol(currentData.authentication.type) !=
+         AuthToProtocol(profileDataPtr->authentication.type)) ||
+        (strcmp(currentData.authentication.userName,
+                profileDataPtr->authentication.userName) != 0) ||
+        (strcmp(currentData.authentication.password,
+                profileDataPtr->authentication.password) != 0))
+    {
+        if (AuthToProtocol(profileDataPtr->authentication.type))
+        {
+            snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE,
+                     "AT+CGAUTH=%"PRIu32",%d,\"%s\",\"%s\"",
+                     profileIndex,
+                     AuthToProtocol(profileDataPtr->authentication.type),
+                     profileDataPtr->authentication.userName,
+                     profileDataPtr->authentication.password);
+        }
+        else
+        {
+            snprintf(commandStr, PA_AT_LOCAL_LONG_STRING_SIZE, "AT+CGAUTH=%"PRIu32",0",
+                     profileIndex);
+        }
+        res = SendCommand(commandStr);
+        isWritten = true;
+        if (res != LE_OK)
+        {
+            LE_ERROR("Write authentication failed !");
+        }
+    }
+
+    if (isWritten)
     {
-        LE_ERROR("Write profile failed !");
+        // The contexts are read again from the modem on next access
+        pa_mdc_utils_InvalidateProfileCache();
     }
     else
     {
-        le_atClient_Delete(cmdRef);
+        LE_DEBUG("Profile %"PRIu32" is up to date", profileIndex);
+        res = LE_OK;
     }
+
     return res;
 }
 
@@ -752,13 +1903,25 @@ le_result_t pa_mdc_StartSessionIPV4
     uint32_t profileIndex        ///< [IN] The profile to use
 )
 {
-    le_result_t res = LE_FAULT;
+    le_result_t    res = LE_FAULT;
+    DataSession_t* sessionPtr = GetDataSession(profileIndex);
+
+    if (NULL == sessionPtr)
+    {
+        LE_ERROR("Invalid profile index %"PRIu32, profileIndex);
+        return LE_FAULT;
+    }
 
-    if (GetCurrentDataSessionIndex() != INVALID_PROFILE_INDEX)
+    if ((LE_MDC_DISCONNECTED != GetDataSessionState(sessionPtr)) || (sessionPtr->pid))
     {
         return LE_DUPLICATE;
     }
 
+    if (AllocatePppPort(&sessionPtr->portIndex) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
     // Always executed because:
     //   - if GPRS is already attached it doesn't do anything and then it returns OK
     //   - if GPRS is not attached it will attach it and then it returns OK on success
@@ -775,13 +1938,18 @@ le_result_t pa_mdc_StartSessionIPV4
         return LE_FAULT;
     }
 
-    if ((res = EstablishConnection(profileIndex)) != LE_OK)
+    // The session is connecting until pppd reports the end of the negotiation
+    SetDataSessionState(sessionPtr, LE_MDC_AUTHENTICATING);
+
+    if ((res = EstablishConnection(sessionPtr)) != LE_OK)
     {
-        SetCurrentDataSessionIndex(INVALID_PROFILE_INDEX);
+        SetDataSessionState(sessionPtr, LE_MDC_DISCONNECTED);
         return LE_FAULT;
     }
 
-    SetCurrentDataSessionIndex(profileIndex);
+    // The session is reconnected if the network drops it once it has been connected: a failure
+    // of the first negotiation is reported to the caller and not retried
+    sessionPtr->isAutoReconnect = true;
 
     return res;
 }
@@ -840,18 +2008,33 @@ le_result_t pa_mdc_StopSession
     uint32_t profileIndex        ///< [IN] The profile to use
 )
 {
-    if (GetCurrentDataSessionIndex() == INVALID_PROFILE_INDEX)
+    DataSession_t* sessionPtr = GetDataSession(profileIndex);
+
+    if (NULL == sessionPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    // A session stopped on request is not reconnected
+    sessionPtr->isAutoReconnect = false;
+    sessionPtr->wasConnected = false;
+    sessionPtr->isReconnecting = false;
+    le_timer_Stop(sessionPtr->reconnectTimerRef);
+
+    if ((LE_MDC_DISCONNECTED == GetDataSessionState(sessionPtr)) && (0 == sessionPtr->pid))
     {
         return LE_FAULT;
     }
 
-    // Stop the PDP connection on modem side
-    if (StopPDPConnection() != LE_OK)
+    StopPPPInterface(sessionPtr);
+
+    // Deactivate only the context of this session on modem side, the other sessions stay up
+    if (ActivateContext(profileIndex, false) != LE_OK)
     {
         return LE_FAULT;
     }
 
-    SetCurrentDataSessionIndex(INVALID_PROFILE_INDEX);
+    ReportSessionState(sessionPtr, LE_MDC_DISCONNECTED);
 
     return LE_OK;
 }
@@ -872,16 +2055,15 @@ le_result_t pa_mdc_GetSessionState
     le_mdc_ConState_t* sessionStatePtr        ///< [OUT] The data session state
 )
 {
-    // All other profiles are always disconnected
-    if (profileIndex != GetCurrentDataSessionIndex())
-    {
-        *sessionStatePtr = LE_MDC_DISCONNECTED;
-    }
-    else
+    DataSession_t* sessionPtr = GetDataSession(profileIndex);
+
+    if (NULL == sessionPtr)
     {
-        *sessionStatePtr = LE_MDC_CONNECTED;
+        return LE_FAULT;
     }
 
+    *sessionStatePtr = GetDataSessionState(sessionPtr);
+
     return LE_OK;
 }
 
@@ -939,22 +2121,19 @@ le_result_t pa_mdc_GetInterfaceName
     size_t   interfaceNameStrSize             ///< [IN] The size in bytes of the name buffer
 )
 {
-    // The interface name will always be of the form pppX, where X is an integer starting at zero.
-    // Only one network interface is currently supported, thus X is 0, so hard-code the name.
-    const char pppInterfaceNameStr[] = "ppp0";
-
-    le_mdc_ConState_t sessionState;
-    le_result_t res;
+    DataSession_t* sessionPtr = GetDataSession(profileIndex);
 
-    res = pa_mdc_GetSessionState(profileIndex, &sessionState);
-    if ((res != LE_OK) || (sessionState != LE_MDC_CONNECTED))
+    // The interface name is the one reported by the pppd of the session, of the form pppX
+    if ((NULL == sessionPtr) || (LE_MDC_CONNECTED != GetDataSessionState(sessionPtr)) ||
+        (NULL_CHAR == sessionPtr->interfaceName[0]))
     {
         return LE_FAULT;
     }
 
-    if (le_utf8_Copy(interfaceNameStr,pppInterfaceNameStr,interfaceNameStrSize, NULL) == LE_OVERFLOW)
+    if (le_utf8_Copy(interfaceNameStr, sessionPtr->interfaceName, interfaceNameStrSize, NULL)
+        == LE_OVERFLOW)
     {
-        LE_ERROR("Interface name '%s' is too long", pppInterfaceNameStr);
+        LE_ERROR("Interface name '%s' is too long", sessionPtr->interfaceName);
         return LE_OVERFLOW;
     }
 
@@ -982,16 +2161,8 @@ le_result_t pa_mdc_GetIPAddress
     size_t                 ipAddrStrSize       ///< [IN] The size in bytes of the address buffer
 )
 {
-    le_atClient_CmdRef_t cmdRef   = NULL;
-    le_result_t          res      = LE_FAULT;
-    char*                tokenPtr = NULL;
-    char*                savePtr  = NULL;
-
-    static const char    cgpaddrStr[]="AT+CGPADDR=";
-    char                 commandStr[sizeof(cgpaddrStr)+PA_AT_COMMAND_PADDING];
-    char                 responseStr[PA_AT_LOCAL_LONG_STRING_SIZE];
-    char                 ipAddr1Str[PA_AT_LOCAL_STRING_SIZE] = {0};
-    char                 ipAddr2Str[PA_AT_LOCAL_STRING_SIZE] = {0};
+    pa_mdc_utils_IpParam_t ipParam;
+    le_result_t            res;
 
     if (!profileIndex)
     {
@@ -999,88 +2170,22 @@ le_result_t pa_mdc_GetIPAddress
         return LE_BAD_PARAMETER;
     }
 
-    // 3GPP 27.007
-    // AT+CGPADDR
-    // +CGPADDR: 1,"10.29.164.168","254.128.0.0.0.0.0.0.90.159.101.12.150.163.37.78"
-    snprintf(commandStr, sizeof(commandStr),"%s%"PRIu32, cgpaddrStr, profileIndex);
-    snprintf(responseStr, sizeof(responseStr),"+CGPADDR: %"PRIu32",", profileIndex);
-
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        commandStr,
-                                        responseStr,
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
+    res = pa_mdc_utils_GetIpParam(profileIndex, ipVersion, &ipParam);
     if (res != LE_OK)
     {
-        LE_ERROR("Failed to send the command");
         return res;
     }
 
-    responseStr[0] = NULL_CHAR;
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       responseStr,
-                                       sizeof(responseStr));
-
-    if ((res != LE_OK) || (strcmp(responseStr,"OK") != 0))
-    {
-        LE_ERROR("Failed to get the final response");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
-    }
-
-    responseStr[0] = NULL_CHAR;
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   responseStr,
-                                                   sizeof(responseStr));
-
-    le_atClient_Delete(cmdRef);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the intermediate response");
-        return LE_FAULT;
-    }
-
-    tokenPtr = strtok_r(responseStr, "\"", &savePtr);
-    if(tokenPtr)
-    {
-        tokenPtr = strtok_r(NULL, "\"", &savePtr);
-        if(tokenPtr)
-        {
-            strncpy(ipAddr1Str, tokenPtr, sizeof(ipAddr1Str));
-            tokenPtr = strtok_r(NULL, "\"", &savePtr);
-            if(tokenPtr)
-            {
-                tokenPtr = strtok_r(NULL, "\"", &savePtr);
-                if(tokenPtr)
-                {
-                    strncpy(ipAddr2Str, tokenPtr, sizeof(ipAddr2Str));
-                }
-            }
-        }
-    }
-
-    pa_utils_RemoveQuotationString(ipAddr1Str);
-    pa_utils_RemoveQuotationString(ipAddr2Str);
-
-    if(pa_mdc_util_CheckConvertIPAddressFormat(ipAddr1Str, ipVersion))
-    {
-        res = le_utf8_Copy(ipAddrStr, ipAddr1Str, ipAddrStrSize, NULL);
-    }
-    else if(pa_mdc_util_CheckConvertIPAddressFormat(ipAddr2Str, ipVersion))
-    {
-        res = le_utf8_Copy(ipAddrStr, ipAddr2Str, ipAddrStrSize, NULL);
-    }
-    else
+    if (NULL_CHAR == ipParam.addr[0])
     {
         LE_ERROR("No Ip address");
-        res = LE_FAULT;
+        return LE_FAULT;
     }
 
-    return res;
+    return le_utf8_Copy(ipAddrStr, ipParam.addr, ipAddrStrSize, NULL);
 }
 
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the primary/secondary DNS addresses for the given profile, if the data session is connected.
@@ -1105,11 +2210,9 @@ le_result_t pa_mdc_GetDNSAddresses
     size_t                 dns2AddrStrSize  ///< [IN]  The size in bytes of the dns2AddrStr buffer
 )
 {
-#if LE_CONFIG_LINUX
-    struct sockaddr_in addr;
-    struct __res_state res;
-    le_mdc_ConState_t  sessionState;
-    le_result_t        result = LE_OK;
+    pa_mdc_utils_IpParam_t ipParam;
+    le_mdc_ConState_t      sessionState;
+    le_result_t            result;
 
     result = pa_mdc_GetSessionState(profileIndex, &sessionState);
     if ((result != LE_OK) || (sessionState != LE_MDC_CONNECTED))
@@ -1117,51 +2220,24 @@ le_result_t pa_mdc_GetDNSAddresses
         return LE_FAULT;
     }
 
-    memset(dns1AddrStr,0,dns1AddrStrSize);
-    memset(dns2AddrStr,0,dns1AddrStrSize);
-
-    res.options &= ~ (RES_INIT);
-    if (res_ninit(&res)==-1)
+    // The DNS addresses are the ones given by the network for the PDP context
+    result = pa_mdc_utils_GetIpParam(profileIndex, ipVersion, &ipParam);
+    if (result != LE_OK)
     {
         return LE_FAULT;
     }
 
-    if (res.nscount > 0)
+    if ((le_utf8_Copy(dns1AddrStr, ipParam.dns1, dns1AddrStrSize, NULL) != LE_OK) ||
+        (le_utf8_Copy(dns2AddrStr, ipParam.dns2, dns2AddrStrSize, NULL) != LE_OK))
     {
-        addr = res.nsaddr_list[0];
-
-        if ( dns1AddrStrSize < INET_ADDRSTRLEN)
-        {
-            return LE_OVERFLOW;
-        }
-
-        // Now get it back and save it
-        if ( inet_ntop(AF_INET, &(addr.sin_addr), dns1AddrStr, INET_ADDRSTRLEN) == NULL)
-        {
-            return LE_FAULT;
-        }
+        return LE_OVERFLOW;
     }
 
-    if (res.nscount > 1)
-    {
-        addr = res.nsaddr_list[1];
-
-        if ( dns2AddrStrSize < INET_ADDRSTRLEN)
-        {
-            return LE_OVERFLOW;
-        }
-
-        // Now get it back and save it
-        if ( inet_ntop(AF_INET, &(addr.sin_addr), dns2AddrStr, INET_ADDRSTRLEN) == NULL)
-        {
-            return LE_FAULT;
-        }
-    }
-#endif
     return LE_OK;
 }
 
 
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the Access Point Name for the given profile, if the data session is connected.
@@ -1181,97 +2257,64 @@ le_result_t pa_mdc_GetAccessPointName
     size_t   apnNameStrSize              ///< [IN]  The size in bytes of the address buffer
 )
 {
-    le_atClient_CmdRef_t cmdRef   = NULL;
-    le_result_t          res      = LE_FAULT;
-    char*                tokenPtr = NULL;
-    char*                savePtr  = NULL;
-    char                 responseStr[PA_AT_LOCAL_LONG_STRING_SIZE] = {0};
+    pa_mdc_ProfileData_t profileData;
+    le_result_t          res;
 
-    if (!profileIndex)
+    if ((!profileIndex) || (!apnNameStr))
     {
         LE_DEBUG("One parameter is NULL");
         return LE_BAD_PARAMETER;
     }
 
-    snprintf(responseStr,PA_AT_LOCAL_LONG_STRING_SIZE,"+CGDCONT: %"PRIu32",", profileIndex);
-
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CGDCONT?",
-                                        responseStr,
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-    if (res != LE_OK)
+    res = pa_mdc_utils_GetCachedProfile(profileIndex, &profileData);
+    if (LE_NOT_FOUND == res)
     {
-        LE_ERROR("Failed to send the command");
-        return res;
+        LE_DEBUG("No PDP context defined for profile %"PRIu32, profileIndex);
+        return LE_FAULT;
     }
-
-    responseStr[0] = NULL_CHAR;
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       responseStr,
-                                       sizeof(responseStr));
-
-    if (res != LE_OK)
+    else if (LE_OK != res)
     {
-        LE_ERROR("Failed to get the final response");
-        le_atClient_Delete(cmdRef);
         return res;
     }
-    else if (strcmp(responseStr,"OK") != 0)
-    {
-        LE_ERROR("Final response not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
-    }
 
-    responseStr[0] = NULL_CHAR;
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   responseStr,
-                                                   sizeof(responseStr));
+    return le_utf8_Copy(apnNameStr, profileData.apn, apnNameStrSize, NULL);
+}
 
-    le_atClient_Delete(cmdRef);
 
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the intermediate response");
-    }
-    else
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the <AcT> of the serving cell (3GPP 27.007) into a data bearer technology
+ *
+ * @return The data bearer technology
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mdc_DataBearerTechnology_t ConvertActToDataBearerTechnology
+(
+    int act                     ///< [IN] The <AcT> of the serving cell
+)
+{
+    switch (act)
     {
-        //  Look for APN string
-        //  AT+CGDCONT?
-        //  +CGDCONT: 1,"<pdp type>","<apn>",,0,0,0,0,0,,0)
-        //  +CGDCONT: 1,"IPV4V6",,,0,0,0,0,0,,0
-        //  +CGDCONT: 2,"IPV4V6","VZWADMIN",,0,0,0,0,0,,0
-        apnNameStr[0] = '\0';
-
-        //  Look for the first <">
-        tokenPtr = strtok_r(responseStr, "\"", &savePtr);
-        if(tokenPtr)
-        {
-            LE_DEBUG("tokenPtr %s", tokenPtr);
-            int cpt;
-            for (cpt = 0; (cpt < 3) && tokenPtr; cpt++)
-            {
-                tokenPtr = strtok_r(NULL, "\"", &savePtr);
-                LE_DEBUG_IF(tokenPtr, "tokenPtr %d= %s", cpt, tokenPtr);
-            }
-            if (tokenPtr)
-            {
-                LE_DEBUG("tokenPtr %s", tokenPtr);
-                strncpy(apnNameStr, tokenPtr, apnNameStrSize);
-            }
-            else
-            {
-                LE_DEBUG("No APN Found on PDP context");
-            }
-        }
+        case 0:     // GSM
+        case 1:     // GSM Compact
+            return LE_MDC_DATA_BEARER_TECHNOLOGY_GPRS;
+        case 3:     // GSM w/EGPRS
+        case 8:     // EC-GSM-IoT
+            return LE_MDC_DATA_BEARER_TECHNOLOGY_EGPRS;
+        case 2:     // UTRAN
+            return LE_MDC_DATA_BEARER_TECHNOLOGY_WCDMA;
+        case 4:     // UTRAN w/HSDPA
+        case 5:     // UTRAN w/HSUPA
+        case 6:     // UTRAN w/HSDPA and HSUPA
+            return LE_MDC_DATA_BEARER_TECHNOLOGY_HSPA;
+        case 7:     // E-UTRAN
+        case 9:     // E-UTRAN (NB-S1 mode)
+            return LE_MDC_DATA_BEARER_TECHNOLOGY_LTE;
+        default:
+            return LE_MDC_DATA_BEARER_TECHNOLOGY_UNKNOWN;
     }
-
-    return res;
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the Data Bearer Technology for the given profile, if the data session is connected.
@@ -1288,7 +2331,25 @@ le_result_t pa_mdc_GetDataBearerTechnology
     le_mdc_DataBearerTechnology_t* uplinkDataBearerTechPtr    ///< [OUT] Uplink data bearer technology
 )
 {
-    return LE_FAULT;
+    int act;
+
+    if ((!downlinkDataBearerTechPtr) || (!uplinkDataBearerTechPtr))
+    {
+        LE_ERROR("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    // The bearer follows the <AcT> of the serving cell reported by the network registration
+    if (LE_OK != pa_mrc_local_GetCurrentAct(&act))
+    {
+        LE_DEBUG("Access technology of profile %"PRIu32" is not known", profileIndex);
+        return LE_FAULT;
+    }
+
+    *downlinkDataBearerTechPtr = ConvertActToDataBearerTechnology(act);
+    *uplinkDataBearerTechPtr = *downlinkDataBearerTechPtr;
+
+    return LE_OK;
 }
 
 
@@ -1306,7 +2367,15 @@ le_result_t pa_mdc_GetDataFlowStatistics
     pa_mdc_PktStatistics_t *dataStatisticsPtr ///< [OUT] Statistics data
 )
 {
-    memset(dataStatisticsPtr,0,sizeof(*dataStatisticsPtr));
+    if (NULL == dataStatisticsPtr)
+    {
+        LE_ERROR("dataStatisticsPtr is NULL");
+        return LE_FAULT;
+    }
+
+    SampleDataFlowCounters();
+    *dataStatisticsPtr = DataFlowCounters.statisticsCount;
+
     return LE_OK;
 }
 
@@ -1324,7 +2393,15 @@ le_result_t pa_mdc_GetDataFlow_without_Statistics
     pa_mdc_PktStatistics_t* dataPtr   ///< [OUT] data
 )
 {
-    memset(dataPtr,0,sizeof(*dataPtr));
+    if (NULL == dataPtr)
+    {
+        LE_ERROR("dataPtr is NULL");
+        return LE_FAULT;
+    }
+
+    SampleDataFlowCounters();
+    *dataPtr = DataFlowCounters.totalCount;
+
     return LE_OK;
 }
 
@@ -1342,7 +2419,11 @@ le_result_t pa_mdc_ResetDataFlowStatistics
     void
 )
 {
-    return LE_FAULT;
+    SampleDataFlowCounters();
+    memset(&DataFlowCounters.totalCount, 0, sizeof(DataFlowCounters.totalCount));
+    memset(&DataFlowCounters.statisticsCount, 0, sizeof(DataFlowCounters.statisticsCount));
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1359,7 +2440,11 @@ le_result_t pa_mdc_StopDataFlowStatistics
     void
 )
 {
-    return LE_FAULT;
+    // Account for the data exchanged until now before stopping the collection
+    SampleDataFlowCounters();
+    DataFlowCounters.isCollecting = false;
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1376,7 +2461,11 @@ le_result_t pa_mdc_StartDataFlowStatistics
     void
 )
 {
-    return LE_FAULT;
+    // Discard the data exchanged while the collection was stopped
+    SampleDataFlowCounters();
+    DataFlowCounters.isCollecting = true;
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -257,8 +257,9 @@ uint16_t pa_mrc_GetServingCellScramblingCode
  * This function gets the Radio Access Technology.
  *
  * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER Bad parameter passed to the function
  * @return LE_TIMEOUT       No response was received.
- * @return LE_FAULT         The function failed to get the Signal strength information.
+ * @return LE_FAULT         The function failed to get the Radio Access Technology.
  */
 //--------------------------------------------------------------------------------------------------
 le_result_t pa_mrc_GetRadioAccessTechInUse
@@ -266,67 +267,22 @@ le_result_t pa_mrc_GetRadioAccessTechInUse
     le_mrc_Rat_t*   ratPtr    ///< [OUT] The Radio Access Technology.
 )
 {
-    le_atClient_CmdRef_t cmdRef  = NULL;
-    le_result_t          res     = LE_FAULT;
-    char*                bandPtr = NULL;
-    int                  bitMask = 0;
-    char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    le_result_t res;
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+KBND?",
-                                        "+KBND:",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       finalResponse,
-                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
-    }
-    else if (strcmp(finalResponse,"OK") != 0)
+    if (!ratPtr)
     {
-        LE_ERROR("Final response not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
+        LE_WARN("One parameter is NULL");
+        return LE_BAD_PARAMETER;
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   intermediateResponse,
-                                                   LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
+    // The RAT is tracked from the <AcT> of +CREG / +CEREG / +COPS
+    res = pa_mrc_local_GetCurrentRat(ratPtr);
+    if (LE_UNAVAILABLE == res)
     {
-        LE_ERROR("Failed to get the response");
+        *ratPtr = LE_MRC_RAT_UNKNOWN;
+        res = LE_OK;
     }
-    else
-    {
-        bandPtr = intermediateResponse+strlen("+KBND: ");
-        bitMask = atoi(bandPtr);
 
-        if ((bitMask >= 1) && (bitMask <= 8))
-        {
-            *ratPtr = LE_MRC_RAT_GSM;
-        }
-        else if ((bitMask >= 10) && (bitMask <= 200))
-        {
-            *ratPtr = LE_MRC_RAT_UMTS;
-        }
-        else
-        {
-            *ratPtr = LE_MRC_RAT_UNKNOWN;
-        }
-    }
-    le_atClient_Delete(cmdRef);
     return res;
 }
 
@@ -346,13 +302,22 @@ int32_t pa_mrc_GetNeighborCellsInfo
     le_dls_List_t* cellInfoListPtr  ///< [OUT] The Neighboring Cells information.
 )
 {
-    return LE_FAULT;
+    return pa_mrc_local_GetNeighborCellsInfo(cellInfoListPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function measures the Signal metrics.
+ * This function measures the Signal metrics with AT+CESQ. The Radio Access Technology is the one
+ * of the measurements reported by the modem.
+ *
+ * - GSM:     ss is the RXLEV in dBm, er is the RXQUAL (0 to 7).
+ * - UMTS:    ss and umtsMetrics.rscp are the RSCP in dBm, umtsMetrics.ecio is the Ec/No in dB
+ *            with 1 decimal place.
+ * - LTE:     ss is the RSRP in dBm, lteMetrics.rsrp is the RSRP in dBm and lteMetrics.rsrq the
+ *            RSRQ in dB, both with 1 decimal place.
  *
+ * @return LE_BAD_PARAMETER Bad parameter passed to the function
+ * @return LE_TIMEOUT       No response was received.
  * @return LE_FAULT         The function failed.
  * @return LE_OK            The function succeeded.
  *
@@ -363,12 +328,77 @@ le_result_t pa_mrc_MeasureSignalMetrics
     pa_mrc_SignalMetrics_t* metricsPtr    ///< [OUT] The signal metrics.
 )
 {
-    le_mrc_Rat_t  rat;
-    int32_t       signal;
+    char        responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
+    le_result_t res;
+    int         rxlev, ber, rscp, ecno, rsrq, rsrp;
+
+    if (!metricsPtr)
+    {
+        LE_WARN("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    res = pa_utils_GetATIntermediateResponse("AT+CESQ", "+CESQ:",
+                                             responseStr, sizeof(responseStr));
+    if (LE_OK != res)
+    {
+        LE_ERROR("Failed to get the response");
+        return res;
+    }
+
+    // +CESQ: <rxlev>,<ber>,<rscp>,<ecno>,<rsrq>,<rsrp>
+    if (pa_utils_CountAndIsolateLineParameters(responseStr) < CESQ_PARAM_RSRP_COUNT_ID)
+    {
+        LE_ERROR("this Response pattern is not expected");
+        return LE_FAULT;
+    }
+
+    rxlev = atoi(pa_utils_IsolateLineParameter(responseStr, CESQ_PARAM_RXLEV_COUNT_ID));
+    ber   = atoi(pa_utils_IsolateLineParameter(responseStr, CESQ_PARAM_BER_COUNT_ID));
+    rscp  = atoi(pa_utils_IsolateLineParameter(responseStr, CESQ_PARAM_RSCP_COUNT_ID));
+    ecno  = atoi(pa_utils_IsolateLineParameter(responseStr, CESQ_PARAM_ECNO_COUNT_ID));
+    rsrq  = atoi(pa_utils_IsolateLineParameter(responseStr, CESQ_PARAM_RSRQ_COUNT_ID));
+    rsrp  = atoi(pa_utils_IsolateLineParameter(responseStr, CESQ_PARAM_RSRP_COUNT_ID));
+
+    memset(metricsPtr, 0, sizeof(pa_mrc_SignalMetrics_t));
+    metricsPtr->er = UINT32_MAX;
+
+    if ((rsrp >= 0) && (rsrp <= 97))
+    {
+        // RSRP: 0 < -140 dBm, n: -141+n dBm; RSRQ: 0 < -19.5 dB, n: -20+n/2 dB
+        metricsPtr->rat = LE_MRC_RAT_LTE;
+        metricsPtr->ss  = rsrp - 141;
+        metricsPtr->lteMetrics.rsrp = (rsrp - 141) * 10;
+        metricsPtr->lteMetrics.rsrq = ((rsrq >= 0) && (rsrq <= 34)) ? (rsrq * 5 - 200) : INT32_MAX;
+        metricsPtr->lteMetrics.snr  = INT32_MAX;
+    }
+    else if ((rscp >= 0) && (rscp <= 96))
+    {
+        // RSCP: 0 < -120 dBm, n: -121+n dBm; Ec/No: 0 < -24 dB, n: -24.5+n/2 dB
+        metricsPtr->rat = LE_MRC_RAT_UMTS;
+        metricsPtr->ss  = rscp - 121;
+        metricsPtr->umtsMetrics.rscp = rscp - 121;
+        metricsPtr->umtsMetrics.ecio = ((ecno >= 0) && (ecno <= 49)) ? (ecno * 5 - 245) : INT32_MAX;
+        metricsPtr->umtsMetrics.sinr = INT32_MAX;
+    }
+    else if ((rxlev >= 0) && (rxlev <= 63))
+    {
+        // RXLEV: 0 < -110 dBm, n: -111+n dBm
+        metricsPtr->rat = LE_MRC_RAT_GSM;
+        metricsPtr->ss  = rxlev - 111;
+        if ((ber >= 0) && (ber <= 7))
+        {
+            metricsPtr->er = ber;
+        }
+    }
+    else
+    {
+        LE_DEBUG("No signal measured");
+        metricsPtr->rat = LE_MRC_RAT_UNKNOWN;
+        return LE_FAULT;
+    }
 
-    metricsPtr->rat = pa_mrc_GetRadioAccessTechInUse(&rat);
-    metricsPtr->ss  = pa_mrc_GetSignalStrength(&signal);
-    metricsPtr->er  = 0xFFFFFFFF;
+    LE_DEBUG("RAT %d, ss %"PRIi32" dBm", metricsPtr->rat, metricsPtr->ss);
 
     return LE_OK;
 }
@@ -10,8 +10,11 @@
 #include "interfaces.h"
 
 #include "pa_sim.h"
+#include "pa_mrc.h"
 #include "pa_utils.h"
+#include "pa_sim_local.h"
 #include "pa_sim_utils_local.h"
+#include "pa_mrc_local.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -29,6 +32,20 @@
 LE_MEM_DEFINE_STATIC_POOL(SimEventPool, DEFAULT_SIMEVENT_POOL_SIZE, sizeof(pa_sim_Event_t));
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM Toolkit event memory pool size
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_STKEVENT_POOL_SIZE  1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Define static SIM Toolkit event memory pool
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(StkEventPool, DEFAULT_STKEVENT_POOL_SIZE, sizeof(pa_sim_StkEvent_t));
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sim memory pool
@@ -36,6 +53,13 @@ LE_MEM_DEFINE_STATIC_POOL(SimEventPool, DEFAULT_SIMEVENT_POOL_SIZE, sizeof(pa_si
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t   SimEventPoolRef;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM Toolkit event memory pool
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t   StkEventPoolRef;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Unsolicited event
@@ -50,6 +74,13 @@ static le_event_Id_t      EventUnsolicitedId;
 //--------------------------------------------------------------------------------------------------
 static le_event_Id_t      EventNewSimStateId;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM Toolkit event
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t      EventStkId;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * External SIM selected by default
@@ -57,6 +88,244 @@ static le_event_Id_t      EventNewSimStateId;
 //--------------------------------------------------------------------------------------------------
 static le_sim_Id_t        UimSelect = LE_SIM_EXTERNAL_SLOT_1;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Minimum delay in milliseconds between two AT+CPIN? resynchronizations while the SIM state is
+ * unknown or busy
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIM_STATE_RESYNC_PERIOD_MS  1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Relative time of the last AT+CPIN? resynchronization
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t      SimStateResyncTime;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of logical channels tracked by the PA
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_LOGICAL_CHANNELS        4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of SIM slots behind a slot selection command
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_SIM_SLOTS               2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logical channel opened on the SIM card.
+ *
+ * A channel is closed on the card as soon as it is released: the selected application and its
+ * security state must not be handed over to another client.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool        isOpen;             ///< Channel opened on the card
+    uint8_t     channel;            ///< Channel number assigned by MANAGE CHANNEL
+}
+LogicalChannel_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logical channels table
+ */
+//--------------------------------------------------------------------------------------------------
+static LogicalChannel_t   LogicalChannels[MAX_LOGICAL_CHANNELS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size in bytes of a cached elementary file
+ */
+//--------------------------------------------------------------------------------------------------
+#define EF_DATA_MAX_BYTES           128
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Elementary file description for AT+CRSM
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*      fileIdPtr;     ///< File identifier
+    const char*      pathPtr;       ///< Path of the file, NULL for the current application
+    le_sim_Command_t command;       ///< Read command
+    uint8_t          length;        ///< Expected length, 0 to let the card tell it
+}
+EfDescriptor_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Elementary files, indexed by pa_sim_local_Ef_t
+ */
+//--------------------------------------------------------------------------------------------------
+static const EfDescriptor_t EfDescriptors[PA_SIM_EF_MAX] =
+{
+    { "2FE2", "3F00", LE_SIM_READ_BINARY, 10 },    // PA_SIM_EF_ICCID
+    { "6F07", NULL,   LE_SIM_READ_BINARY,  9 },    // PA_SIM_EF_IMSI
+    { "6F40", NULL,   LE_SIM_READ_RECORD,  0 },    // PA_SIM_EF_MSISDN
+    { "6F46", NULL,   LE_SIM_READ_BINARY, 17 },    // PA_SIM_EF_SPN
+    { "6F7B", NULL,   LE_SIM_READ_BINARY,  0 },    // PA_SIM_EF_FPLMN
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Elementary file cache entry
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool        isValid;                    ///< Entry filled
+    le_result_t result;                     ///< Read result, LE_OK or LE_NOT_FOUND
+    uint8_t     data[EF_DATA_MAX_BYTES];    ///< File content
+    size_t      len;                        ///< File content length
+}
+EfCacheEntry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM slot context. The context of a slot is kept while another slot is selected, so that
+ * switching back to it only requires checking the ICCID of its card.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sim_States_t state;                  ///< SIM state, kept up to date by the +CPIN and
+                                            ///  +SIMCARD unsolicited responses
+    le_sim_States_t lastKnownState;         ///< Last state reported for the slot
+    bool            isVerified;             ///< Whether the cache belongs to the inserted card,
+                                            ///  i.e. its ICCID has been checked since the last
+                                            ///  time the card was seen absent or selected
+    EfCacheEntry_t  efCache[PA_SIM_EF_MAX]; ///< Elementary files cache of the card
+}
+SimSlot_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM slots contexts, indexed by le_sim_Id_t
+ */
+//--------------------------------------------------------------------------------------------------
+static SimSlot_t          SimSlots[LE_SIM_ID_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the selected slot
+ */
+//--------------------------------------------------------------------------------------------------
+static SimSlot_t*         CurrentSlotPtr = &SimSlots[LE_SIM_EXTERNAL_SLOT_1];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM slot selection command
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* setCmdPtr;                  ///< Selection command format, takes the slot value
+    const char* getCmdPtr;                  ///< Selected slot query
+    const char* prefixPtr;                  ///< Selected slot query response prefix
+    le_sim_Id_t slots[MAX_SIM_SLOTS];       ///< SIM identifiers, indexed by the slot value
+}
+SlotSelectCommand_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM slot selection commands, indexed by pa_sim_SlotSelectProfile_t. Unused slot values are set
+ * to LE_SIM_ID_MAX.
+ */
+//--------------------------------------------------------------------------------------------------
+static const SlotSelectCommand_t SlotSelectCommands[] =
+{
+    [PA_SIM_SLOT_SELECT_NONE]    = { NULL,           NULL,          NULL,
+                                     { LE_SIM_EXTERNAL_SLOT_1, LE_SIM_ID_MAX } },
+    [PA_SIM_SLOT_SELECT_KSIMSEL] = { "AT+KSIMSEL=%d", "AT+KSIMSEL?", "+KSIMSEL:",
+                                     { LE_SIM_EXTERNAL_SLOT_1, LE_SIM_EMBEDDED } },
+    [PA_SIM_SLOT_SELECT_QDSIM]   = { "AT+QDSIM=%d",   "AT+QDSIM?",   "+QDSIM:",
+                                     { LE_SIM_EXTERNAL_SLOT_1, LE_SIM_EXTERNAL_SLOT_2 } },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM slot selection command of the modem
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_sim_SlotSelectProfile_t SlotSelectProfile = PA_SIM_SLOT_SELECT_NONE;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM Toolkit proactive command types (ETSI TS 102 223)
+ */
+//--------------------------------------------------------------------------------------------------
+#define STK_CMD_REFRESH             0x01
+#define STK_CMD_OPEN_CHANNEL        0x40
+#define STK_CMD_END_SESSION         0x81
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM Toolkit BER-TLV and COMPREHENSION-TLV tags (ETSI TS 102 223)
+ */
+//--------------------------------------------------------------------------------------------------
+#define STK_TAG_PROACTIVE_COMMAND   0xD0
+#define STK_TAG_COMMAND_DETAILS     0x01
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size in bytes of a proactive command carried by an unsolicited response
+ */
+//--------------------------------------------------------------------------------------------------
+#define STK_CMD_MAX_BYTES           (LE_ATDEFS_UNSOLICITED_MAX_BYTES / 2)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Last SIM Toolkit event, the _MAX values telling that no event was received
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_sim_StkEvent_t  LastStkEvent =
+{
+    .simId           = LE_SIM_EXTERNAL_SLOT_1,
+    .stkEvent        = LE_SIM_STK_EVENT_MAX,
+    .stkRefreshMode  = LE_SIM_REFRESH_MODE_MAX,
+    .stkRefreshStage = LE_SIM_STAGE_MAX,
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command details (number, type, qualifier) of the proactive command waiting for a confirmation
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t            PendingStkCommand[3];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether a proactive command is waiting for a confirmation
+ */
+//--------------------------------------------------------------------------------------------------
+static bool               IsStkCommandPending = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether a SIM refresh occurred during the current proactive session
+ */
+//--------------------------------------------------------------------------------------------------
+static bool               IsRefreshPending = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response handler references
+ */
+//--------------------------------------------------------------------------------------------------
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCpinRef;
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolSimCardRef;
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolStkPciRef;
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCusatpRef;
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCusatEndRef;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -80,239 +349,340 @@ static void ReportState
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to register a handler for SIM state changing handling.
+ * Read an elementary file from the card with AT+CRSM.
  *
+ * @return LE_OK            The function succeeded.
+ * @return LE_NOT_FOUND     The file does not exist on the card.
+ * @return LE_OVERFLOW      The file does not fit in the buffer.
+ * @return LE_FAULT         The function failed.
  */
 //--------------------------------------------------------------------------------------------------
-static void SimUnsolicitedHandler
+static le_result_t ReadEfFromCard
 (
-    void* reportPtr
+    pa_sim_local_Ef_t ef,       ///< [IN] Elementary file
+    uint8_t*          dataPtr,  ///< [OUT] File content
+    size_t*           lenPtr    ///< [IN/OUT] File content length
 )
 {
-    char*           unsolPtr = reportPtr;
-    le_sim_States_t simState = LE_SIM_STATE_UNKNOWN;
+    const EfDescriptor_t* descPtr = &EfDescriptors[ef];
+    // Read the first record in absolute mode, or the file from offset 0
+    uint8_t               p1 = (LE_SIM_READ_RECORD == descPtr->command) ? 1 : 0;
+    uint8_t               p2 = (LE_SIM_READ_RECORD == descPtr->command) ? 4 : 0;
+    uint8_t               p3 = descPtr->length;
+    uint8_t               sw1 = 0;
+    uint8_t               sw2 = 0;
+    size_t                len = *lenPtr;
+    le_result_t           res;
+
+    res = pa_sim_SendCommand(descPtr->command, descPtr->fileIdPtr, p1, p2, p3, NULL, 0,
+                             descPtr->pathPtr, &sw1, &sw2, dataPtr, &len);
+
+    // Wrong length: the card tells the right one in SW2
+    if ((LE_OK == res) && (0x6C == sw1))
+    {
+        len = *lenPtr;
+        res = pa_sim_SendCommand(descPtr->command, descPtr->fileIdPtr, p1, p2, sw2, NULL, 0,
+                                 descPtr->pathPtr, &sw1, &sw2, dataPtr, &len);
+    }
+
+    if (LE_OK != res)
+    {
+        return res;
+    }
 
-    if (pa_sim_utils_CheckStatus(unsolPtr,&simState))
+    if ((0x90 != sw1) && (0x91 != sw1))
     {
-        ReportState(UimSelect,simState);
+        LE_DEBUG("EF %s read failed, SW %02X%02X", descPtr->fileIdPtr, sw1, sw2);
+        return LE_FAULT;
     }
+
+    *lenPtr = len;
+    return LE_OK;
 }
 
-//--------------------------------------------------------------------------------------------------
-// APIs.
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to initialize the sim module.
+ * Read an elementary file from the card into its cache entry.
  *
- * @return LE_FAULT         The function failed to initialize the module.
- * @return LE_OK            The function succeeded.
+ * Only definite results are cached: the file content, or the card reporting that the file does
+ * not exist. A transient failure, e.g. a busy SIM, leaves the entry invalid so that the file is
+ * read again on its next access.
+ *
+ * @return the read result
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_Init
+static le_result_t FillEfCacheEntry
 (
-    void
+    pa_sim_local_Ef_t ef,           ///< [IN] Elementary file
+    EfCacheEntry_t*   entryPtr      ///< [OUT] Cache entry
 )
 {
-    SimEventPoolRef = le_mem_InitStaticPool(SimEventPool,
-                                            DEFAULT_SIMEVENT_POOL_SIZE,
-                                            sizeof(pa_sim_Event_t));
-
-    EventUnsolicitedId = le_event_CreateId("SIMEventIdUnsol", LE_ATDEFS_UNSOLICITED_MAX_BYTES);
-    EventNewSimStateId = le_event_CreateIdWithRefCounting("SIMEventIdNewState");
-    le_event_AddHandler("SimUnsolicitedHandler", EventUnsolicitedId, SimUnsolicitedHandler);
+    entryPtr->len = sizeof(entryPtr->data);
+    entryPtr->result = ReadEfFromCard(ef, entryPtr->data, &entryPtr->len);
+    entryPtr->isValid = ((LE_OK == entryPtr->result) || (LE_NOT_FOUND == entryPtr->result));
 
-    return LE_OK;
+    return entryPtr->result;
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * This function counts number of sim card available.
+ * Check that the elementary files cache belongs to the inserted card and fill it.
  *
- * @return LE_FAULT         The function failed.
- * @return LE_TIMEOUT       No response was received.
- * @return number           number of count slots
+ * The cache is flushed when the ICCID of the card differs from the cached one (SIM swap).
  */
 //--------------------------------------------------------------------------------------------------
-uint32_t pa_sim_CountSlots
+static void VerifyEfCache
 (
     void
 )
 {
-     return 1;
-}
+    EfCacheEntry_t* efCachePtr = CurrentSlotPtr->efCache;
+    uint8_t         iccid[EF_DATA_MAX_BYTES];
+    size_t          len = sizeof(iccid);
+    uint32_t        ef;
+
+    if (LE_OK != ReadEfFromCard(PA_SIM_EF_ICCID, iccid, &len))
+    {
+        LE_WARN("Unable to read the ICCID, SIM cache disabled");
+        return;
+    }
+
+    if ((!efCachePtr[PA_SIM_EF_ICCID].isValid) || (efCachePtr[PA_SIM_EF_ICCID].len != len)
+        || (0 != memcmp(efCachePtr[PA_SIM_EF_ICCID].data, iccid, len)))
+    {
+        LE_DEBUG("New card inserted, flush the SIM cache");
+        memset(efCachePtr, 0, sizeof(CurrentSlotPtr->efCache));
+        efCachePtr[PA_SIM_EF_ICCID].isValid = true;
+        efCachePtr[PA_SIM_EF_ICCID].result = LE_OK;
+        memcpy(efCachePtr[PA_SIM_EF_ICCID].data, iccid, len);
+        efCachePtr[PA_SIM_EF_ICCID].len = len;
+    }
+
+    CurrentSlotPtr->isVerified = true;
 
+    for (ef = 0; ef < PA_SIM_EF_MAX; ef++)
+    {
+        if (!efCachePtr[ef].isValid)
+        {
+            FillEfCacheEntry(ef, &efCachePtr[ef]);
+        }
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function selects the Card on which all further SIM operations have to be operated.
+ * Get the value of a SIM slot in the slot selection command.
  *
- * @return LE_FAULT         The function failed.
- * @return LE_TIMEOUT       No response was received.
- * @return LE_OK            The function succeeded.
+ * @return the slot value, -1 if the SIM is not available
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_SelectCard
+static int GetSlotValue
 (
-    le_sim_Id_t  cardId     ///< The SIM to be selected
+    le_sim_Id_t simId   ///< [IN] SIM identifier
 )
 {
-    if (cardId != LE_SIM_EXTERNAL_SLOT_1)
+    const SlotSelectCommand_t* commandPtr = &SlotSelectCommands[SlotSelectProfile];
+    int                        i;
+
+    for (i = 0; i < MAX_SIM_SLOTS; i++)
     {
-        return LE_FAULT;
+        if ((LE_SIM_ID_MAX != commandPtr->slots[i]) && (simId == commandPtr->slots[i]))
+        {
+            return i;
+        }
     }
-    UimSelect = cardId;
 
-    return LE_OK;
+    return -1;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function gets sim selection mode.
+ * Make a SIM slot the selected one.
  *
- * @return LE_FAULT         The function failed.
- * @return LE_TIMEOUT       No response was received.
- * @return LE_OK            The function succeeded.
+ * The states of the cards are unknown until the modem reports them. The per-card contexts (logical
+ * channels, remaining attempts) are dropped, while the elementary files cache of the slot is kept
+ * and checked against the ICCID once the card is ready.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_GetSimMode
+static void SwitchSlot
 (
-    le_sim_SimMode_t*  simModePtr     ///< [OUT] The SIM selection mode
+    le_sim_Id_t simId   ///< [IN] SIM identifier
 )
 {
-    *simModePtr = LE_SIM_FORCE_EXTERNAL;
-    return LE_OK;
+    LE_DEBUG("SIM %d -> %d", UimSelect, simId);
+
+    CurrentSlotPtr->state = LE_SIM_STATE_UNKNOWN;
+    CurrentSlotPtr->isVerified = false;
+
+    UimSelect = simId;
+    CurrentSlotPtr = &SimSlots[simId];
+    CurrentSlotPtr->state = LE_SIM_STATE_UNKNOWN;
+    CurrentSlotPtr->isVerified = false;
+    SimStateResyncTime = (le_clk_Time_t){ 0 };
+
+    memset(LogicalChannels, 0, sizeof(LogicalChannels));
+    pa_sim_local_InvalidateRemainingAttempts();
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function get the card on which operations are operated.
+ * Decode the content of EF IMSI: its length, then the digits in BCD, the first nibble being the
+ * parity.
  *
- * @return LE_FAULT         The function failed.
- * @return LE_TIMEOUT       No response was received.
  * @return LE_OK            The function succeeded.
+ * @return LE_FAULT         The content is invalid.
+ * @return LE_OVERFLOW      The IMSI does not fit in the buffer.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_GetSelectedCard
+static le_result_t DecodeImsi
 (
-    le_sim_Id_t*  cardIdPtr     ///< [OUT] The card number selected.
+    const uint8_t* dataPtr,     ///< [IN] EF IMSI content
+    size_t         len,         ///< [IN] EF IMSI content length
+    pa_sim_Imsi_t  imsi         ///< [OUT] IMSI value
 )
 {
-   *cardIdPtr = UimSelect;
-    return LE_OK;
+    if ((len < 2) || (dataPtr[0] < 1) || (dataPtr[0] >= len))
+    {
+        return LE_FAULT;
+    }
+
+    imsi[0] = '0' + (dataPtr[1] >> 4);
+    return pa_sim_utils_DecodeBcd(&dataPtr[2], dataPtr[0] - 1, imsi + 1,
+                                  sizeof(pa_sim_Imsi_t) - 1);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function get the card identification (ICCID).
- *
- * @return LE_OK            The function succeeded.
- * @return LE_BAD_PARAMETER The parameters are invalid.
- * @return LE_TIMEOUT       No response was received.
- * @return LE_FAULT         The function failed.
+ * Update the SIM state cache and notify the registered handlers when the state has changed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_GetCardIdentification
+static void UpdateSimState
 (
-    pa_sim_CardId_t iccid     ///< [OUT] CCID value
+    le_sim_States_t simState  ///< [IN] New SIM state
 )
 {
-    le_atClient_CmdRef_t cmdRef   = NULL;
-    char*                tokenPtr = NULL;
-    le_result_t          res      = LE_OK;
-    char                 responseStr[PA_AT_LOCAL_STRING_SIZE];
-
-    if (!iccid)
+    if (simState == CurrentSlotPtr->state)
     {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
+        return;
     }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CCID",
-                                        "+CCID:",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res != LE_OK)
+    LE_DEBUG("SIM %d state %d -> %d", UimSelect, CurrentSlotPtr->state, simState);
+    CurrentSlotPtr->state = simState;
+    if (LE_SIM_STATE_UNKNOWN != simState)
     {
-        LE_ERROR("Failed to send the command");
-        return res;
+        CurrentSlotPtr->lastKnownState = simState;
     }
+    pa_sim_local_InvalidateRemainingAttempts();
 
-    res = le_atClient_GetFinalResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
+    if ((LE_SIM_READY != simState) && (LE_SIM_STATE_UNKNOWN != simState))
+    {
+        // Logical channels do not survive a SIM removal, lock or reset
+        memset(LogicalChannels, 0, sizeof(LogicalChannels));
+    }
 
-    if (res != LE_OK)
+    if (LE_SIM_ABSENT == simState)
     {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
+        // The card may be swapped, its ICCID is checked again once ready
+        CurrentSlotPtr->isVerified = false;
     }
-    else if (strcmp(responseStr,"OK") != 0)
+    else if ((LE_SIM_READY == simState) && (!CurrentSlotPtr->isVerified))
     {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
+        VerifyEfCache();
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
-    le_atClient_Delete(cmdRef);
-
-    if (res != LE_OK)
+    if (LE_SIM_STATE_UNKNOWN != simState)
     {
-        LE_ERROR("Failed to get the response");
-        return res;
+        ReportState(UimSelect, simState);
     }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register a handler for SIM state changing handling.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void SimUnsolicitedHandler
+(
+    void* reportPtr
+)
+{
+    char*           unsolPtr = reportPtr;
+    le_sim_States_t simState = LE_SIM_STATE_UNKNOWN;
 
-    // Cut the string for keep just the CCID number
-    tokenPtr = strtok(responseStr,"+CCID: ");
-    if(tokenPtr)
+    if (FIND_STRING("+SIMCARD:", unsolPtr))
     {
-        strncpy(iccid, tokenPtr, strlen(tokenPtr));
+        pa_utils_CountAndIsolateLineParameters(unsolPtr);
+
+        if (0 == atoi(pa_utils_IsolateLineParameter(unsolPtr, 2)))
+        {
+            UpdateSimState(LE_SIM_ABSENT);
+        }
+        else
+        {
+            // Only the card presence is known: the lock state is given by the +CPIN report
+            // following it, or resolved with AT+CPIN? on the next pa_sim_GetState()
+            UpdateSimState(LE_SIM_STATE_UNKNOWN);
+            SimStateResyncTime = (le_clk_Time_t){ 0 };
+        }
     }
-    else
+    else if (pa_sim_utils_CheckStatus(unsolPtr,&simState))
     {
-        res= LE_FAULT;
+        UpdateSimState(simState);
     }
-
-    return res;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the +CPIN and +SIMCARD unsolicited responses: forward the line to the SIM unsolicited
+ * event.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SimStateUnsolHandler
+(
+    const char* unsolPtr,
+    void*       contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    char unsolStr[LE_ATDEFS_UNSOLICITED_MAX_BYTES] = {0};
+
+    if (!unsolPtr)
+    {
+        LE_ERROR("unsolPtr NULL");
+        return;
+    }
+
+    le_utf8_Copy(unsolStr, unsolPtr, sizeof(unsolStr), NULL);
+    le_event_Report(EventUnsolicitedId, unsolStr, sizeof(unsolStr));
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function get the International Mobile Subscriber Identity (IMSI).
+ * Read the SIM state with AT+CPIN? and update the cache.
  *
  * @return LE_OK            The function succeeded.
- * @return LE_BAD_PARAMETER The parameters are invalid.
  * @return LE_TIMEOUT       No response was received.
  * @return LE_FAULT         The function failed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_GetIMSI
+static le_result_t ResyncSimState
 (
-    pa_sim_Imsi_t imsi   ///< [OUT] IMSI value
+    void
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-    char                 responseStr[PA_AT_LOCAL_STRING_SIZE];
+    le_atClient_CmdRef_t cmdRef   = NULL;
+    le_result_t          res      = LE_OK;
+    le_sim_States_t      simState = LE_SIM_STATE_UNKNOWN;
+    char                 responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
 
-    if (!imsi)
-    {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
-    }
+    SimStateResyncTime = le_clk_GetRelativeTime();
 
     res = le_atClient_SetCommandAndSend(&cmdRef,
                                         pa_utils_GetAtDeviceRef(),
-                                        "AT+CIMI",
-                                        "0|1|2|3|4|5|6|7|8|9",
+                                        "AT+CPIN?",
+                                        "+CPIN:",
                                         DEFAULT_AT_RESPONSE,
                                         DEFAULT_AT_CMD_TIMEOUT);
 
@@ -332,11 +702,18 @@ le_result_t pa_sim_GetIMSI
         le_atClient_Delete(cmdRef);
         return res;
     }
-    else if (strcmp(responseStr,"OK") != 0)
+
+    if (strcmp(responseStr,"OK") != 0)
     {
-        LE_ERROR("Final response is not OK");
+        // A +CME ERROR final response still tells the SIM state (absent, busy, ...)
         le_atClient_Delete(cmdRef);
-        return LE_FAULT;
+        if (!pa_sim_utils_CheckStatus(responseStr, &simState))
+        {
+            LE_ERROR("Final response is not OK");
+            return LE_FAULT;
+        }
+        UpdateSimState(simState);
+        return LE_OK;
     }
 
     res = le_atClient_GetFirstIntermediateResponse(cmdRef,
@@ -350,222 +727,1081 @@ le_result_t pa_sim_GetIMSI
         return res;
     }
 
-    strncpy(imsi, responseStr, sizeof(pa_sim_Imsi_t));
-    return res;
+    if (!pa_sim_utils_CheckStatus(responseStr, &simState))
+    {
+        return LE_FAULT;
+    }
+
+    UpdateSimState(simState);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store and report a SIM Toolkit event.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportStkEvent
+(
+    le_sim_StkEvent_t        stkEvent,  ///< [IN] SIM Toolkit event
+    le_sim_StkRefreshMode_t  mode,      ///< [IN] Refresh mode
+    le_sim_StkRefreshStage_t stage      ///< [IN] Refresh stage
+)
+{
+    pa_sim_StkEvent_t* eventPtr = le_mem_ForceAlloc(StkEventPoolRef);
+
+    LastStkEvent.simId = UimSelect;
+    LastStkEvent.stkEvent = stkEvent;
+    LastStkEvent.stkRefreshMode = mode;
+    LastStkEvent.stkRefreshStage = stage;
+    *eventPtr = LastStkEvent;
+
+    LE_DEBUG("Send STK event %d, refresh mode %d, stage %d", stkEvent, mode, stage);
+    le_event_ReportWithRefCounting(EventStkId, eventPtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop everything read from the SIM after a refresh: elementary files, PIN counters, logical
+ * channels and, when the network application is reset, the SIM and registration states.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InvalidateSimCaches
+(
+    le_sim_StkRefreshMode_t mode    ///< [IN] Refresh mode
+)
+{
+    pa_sim_local_InvalidateEfCache();
+    pa_sim_local_InvalidateRemainingAttempts();
+
+    if (LE_SIM_REFRESH_FCN != mode)
+    {
+        memset(LogicalChannels, 0, sizeof(LogicalChannels));
+        pa_sim_local_InvalidateState();
+        pa_mrc_local_InvalidateRegistrationState();
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function get the SIM Status.
+ * Extract the command details of a proactive command.
  *
  * @return LE_OK            The function succeeded.
- * @return LE_BAD_PARAMETER The parameters are invalid.
- * @return LE_TIMEOUT       No response was received.
- * @return LE_FAULT         The function failed.
+ * @return LE_FAULT         The proactive command is malformed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_GetState
+static le_result_t ParseProactiveCommand
 (
-    le_sim_States_t* statePtr    ///< [OUT] SIM state
+    const uint8_t* cmdPtr,      ///< [IN] Proactive command BER-TLV
+    size_t         cmdLen,      ///< [IN] Proactive command length
+    uint8_t*       detailsPtr   ///< [OUT] Command number, type and qualifier
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-    char                 responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
+    size_t offset = 2;
+    size_t len;
 
-    if (!statePtr)
+    if ((cmdLen < 2) || (STK_TAG_PROACTIVE_COMMAND != cmdPtr[0]))
     {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
+        return LE_FAULT;
     }
 
-   *statePtr = LE_SIM_STATE_UNKNOWN;
+    // Length on one byte, or two bytes prefixed by 0x81
+    len = cmdPtr[1];
+    if (0x81 == len)
+    {
+        if (cmdLen < 3)
+        {
+            return LE_FAULT;
+        }
+        len = cmdPtr[2];
+        offset = 3;
+    }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CPIN?",
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
+    if ((offset + len) < cmdLen)
+    {
+        cmdLen = offset + len;
+    }
 
-    if (res != LE_OK)
+    while ((offset + 2) <= cmdLen)
     {
-        LE_ERROR("Failed to send the command");
-        return res;
+        uint8_t tag = cmdPtr[offset] & 0x7F;
+        uint8_t tlvLen = cmdPtr[offset + 1];
+
+        if ((offset + 2 + tlvLen) > cmdLen)
+        {
+            break;
+        }
+
+        if ((STK_TAG_COMMAND_DETAILS == tag) && (3 == tlvLen))
+        {
+            memcpy(detailsPtr, &cmdPtr[offset + 2], 3);
+            return LE_OK;
+        }
+
+        offset += 2 + tlvLen;
     }
 
-    res = le_atClient_GetFinalResponse(cmdRef,
-        responseStr,
-        sizeof(responseStr));
+    return LE_FAULT;
+}
 
-    if (res != LE_OK)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handle the end of a proactive session.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndStkSession
+(
+    void
+)
+{
+    // The files are read again after the refresh is completed by the card
+    if (IsRefreshPending)
     {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
+        InvalidateSimCaches(LastStkEvent.stkRefreshMode);
+        IsRefreshPending = false;
+    }
+
+    IsStkCommandPending = false;
+    ReportStkEvent(LE_SIM_END_SESSION, LE_SIM_REFRESH_MODE_MAX, LE_SIM_STAGE_MAX);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the SIM Toolkit unsolicited responses:
+ *  - +CUSATP: <proactive_command> (3GPP TS 27.007)
+ *  - +STKPCI: <type>,<proactive_command>
+ *  - +CUSATEND
+ */
+//--------------------------------------------------------------------------------------------------
+static void StkUnsolHandler
+(
+    const char* unsolPtr,
+    void*       contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    char     unsolStr[LE_ATDEFS_UNSOLICITED_MAX_BYTES] = {0};
+    uint8_t  cmd[STK_CMD_MAX_BYTES];
+    uint8_t  details[3];
+    char*    hexPtr;
+    uint32_t nbParam;
+    int32_t  cmdLen;
+
+    if (!unsolPtr)
+    {
+        LE_ERROR("unsolPtr NULL");
+        return;
+    }
+
+    if (FIND_STRING("+CUSATEND", unsolPtr))
+    {
+        EndStkSession();
+        return;
+    }
+
+    le_utf8_Copy(unsolStr, unsolPtr, sizeof(unsolStr), NULL);
+
+    // The proactive command is the last parameter
+    nbParam = pa_utils_CountAndIsolateLineParameters(unsolStr);
+    if (nbParam < 2)
+    {
+        LE_ERROR("Malformed STK indication");
+        return;
     }
-    else if (strcmp(responseStr,"OK") != 0)
+    hexPtr = pa_utils_IsolateLineParameter(unsolStr, nbParam);
+    pa_utils_RemoveQuotationString(hexPtr);
+
+    cmdLen = le_hex_StringToBinary(hexPtr, strlen(hexPtr), cmd, sizeof(cmd));
+    if ((cmdLen < 0) || (LE_OK != ParseProactiveCommand(cmd, cmdLen, details)))
     {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
+        LE_ERROR("Malformed proactive command");
+        return;
+    }
+
+    LE_DEBUG("Proactive command type 0x%02X, qualifier 0x%02X", details[1], details[2]);
+
+    switch (details[1])
+    {
+        case STK_CMD_REFRESH:
+        {
+            le_sim_StkRefreshMode_t mode = (details[2] < LE_SIM_REFRESH_MODE_MAX) ?
+                                           (le_sim_StkRefreshMode_t) details[2] :
+                                           LE_SIM_REFRESH_RESET;
+
+            memcpy(PendingStkCommand, details, sizeof(PendingStkCommand));
+            IsStkCommandPending = true;
+            IsRefreshPending = true;
+
+            InvalidateSimCaches(mode);
+            ReportStkEvent(LE_SIM_REFRESH, mode, LE_SIM_STAGE_WAITING_FOR_OK);
+            break;
+        }
+        case STK_CMD_OPEN_CHANNEL:
+        {
+            memcpy(PendingStkCommand, details, sizeof(PendingStkCommand));
+            IsStkCommandPending = true;
+
+            ReportStkEvent(LE_SIM_OPEN_CHANNEL, LE_SIM_REFRESH_MODE_MAX, LE_SIM_STAGE_MAX);
+            break;
+        }
+        case STK_CMD_END_SESSION:
+        {
+            EndStkSession();
+            break;
+        }
+        default:
+        {
+            LE_DEBUG("Proactive command not handled");
+            break;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+// APIs.
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to initialize the sim module.
+ *
+ * @return LE_FAULT         The function failed to initialize the module.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_Init
+(
+    void
+)
+{
+    uint32_t i;
+
+    for (i = 0; i < LE_SIM_ID_MAX; i++)
+    {
+        SimSlots[i].state = LE_SIM_STATE_UNKNOWN;
+        SimSlots[i].lastKnownState = LE_SIM_STATE_UNKNOWN;
+    }
+
+    SimEventPoolRef = le_mem_InitStaticPool(SimEventPool,
+                                            DEFAULT_SIMEVENT_POOL_SIZE,
+                                            sizeof(pa_sim_Event_t));
+
+    EventUnsolicitedId = le_event_CreateId("SIMEventIdUnsol", LE_ATDEFS_UNSOLICITED_MAX_BYTES);
+    EventNewSimStateId = le_event_CreateIdWithRefCounting("SIMEventIdNewState");
+    le_event_AddHandler("SimUnsolicitedHandler", EventUnsolicitedId, SimUnsolicitedHandler);
+
+    UnsolCpinRef = le_atClient_AddUnsolicitedResponseHandler("+CPIN:",
+                                                             pa_utils_GetAtDeviceRef(),
+                                                             SimStateUnsolHandler,
+                                                             NULL,
+                                                             1);
+    UnsolSimCardRef = le_atClient_AddUnsolicitedResponseHandler("+SIMCARD:",
+                                                                pa_utils_GetAtDeviceRef(),
+                                                                SimStateUnsolHandler,
+                                                                NULL,
+                                                                1);
+
+    StkEventPoolRef = le_mem_InitStaticPool(StkEventPool,
+                                            DEFAULT_STKEVENT_POOL_SIZE,
+                                            sizeof(pa_sim_StkEvent_t));
+    EventStkId = le_event_CreateIdWithRefCounting("SIMEventIdStk");
+
+    UnsolStkPciRef = le_atClient_AddUnsolicitedResponseHandler("+STKPCI:",
+                                                               pa_utils_GetAtDeviceRef(),
+                                                               StkUnsolHandler,
+                                                               NULL,
+                                                               1);
+    UnsolCusatpRef = le_atClient_AddUnsolicitedResponseHandler("+CUSATP:",
+                                                               pa_utils_GetAtDeviceRef(),
+                                                               StkUnsolHandler,
+                                                               NULL,
+                                                               1);
+    UnsolCusatEndRef = le_atClient_AddUnsolicitedResponseHandler("+CUSATEND",
+                                                                 pa_utils_GetAtDeviceRef(),
+                                                                 StkUnsolHandler,
+                                                                 NULL,
+                                                                 1);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function counts number of sim card available.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_TIMEOUT       No response was received.
+ * @return number           number of count slots
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t pa_sim_CountSlots
+(
+    void
+)
+{
+    const SlotSelectCommand_t* commandPtr = &SlotSelectCommands[SlotSelectProfile];
+    uint32_t                   count = 0;
+    uint32_t                   i;
+
+    for (i = 0; i < MAX_SIM_SLOTS; i++)
+    {
+        if (LE_SIM_ID_MAX != commandPtr->slots[i])
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function selects the Card on which all further SIM operations have to be operated.
+ *
+ * The context of the previous slot is kept: when switching back to it, only the ICCID of its card
+ * is read again to check that the cached files still belong to it.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_SelectCard
+(
+    le_sim_Id_t  cardId     ///< The SIM to be selected
+)
+{
+    const SlotSelectCommand_t* commandPtr = &SlotSelectCommands[SlotSelectProfile];
+    char                       command[PA_AT_LOCAL_SHORT_SIZE];
+    int                        slot = GetSlotValue(cardId);
+
+    if (slot < 0)
+    {
+        LE_ERROR("SIM %d not available", cardId);
+        return LE_FAULT;
+    }
+
+    if (cardId == UimSelect)
+    {
+        return LE_OK;
+    }
+
+    snprintf(command, sizeof(command), commandPtr->setCmdPtr, slot);
+    if (LE_OK != pa_utils_SendATCommandOK(command))
+    {
+        LE_ERROR("Failed to select SIM %d", cardId);
         return LE_FAULT;
     }
 
+    SwitchSlot(cardId);
 
-    if (pa_sim_utils_CheckStatus(responseStr,statePtr))
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets sim selection mode.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t __attribute__((weak)) pa_sim_GetSimMode
+(
+    le_sim_SimMode_t*  simModePtr     ///< [OUT] The SIM selection mode
+)
+{
+    *simModePtr = LE_SIM_FORCE_EXTERNAL;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function get the card on which operations are operated.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_GetSelectedCard
+(
+    le_sim_Id_t*  cardIdPtr     ///< [OUT] The card number selected.
+)
+{
+   *cardIdPtr = UimSelect;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function get the card identification (ICCID).
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_GetCardIdentification
+(
+    pa_sim_CardId_t iccid     ///< [OUT] CCID value
+)
+{
+    uint8_t     data[EF_DATA_MAX_BYTES];
+    size_t      len = sizeof(data);
+    le_result_t res;
+
+    if (!iccid)
+    {
+        LE_DEBUG("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    res = pa_sim_local_ReadEf(PA_SIM_EF_ICCID, data, &len);
+    if (LE_OK != res)
+    {
+        LE_ERROR("Failed to read the ICCID");
+        return LE_FAULT;
+    }
+
+    return pa_sim_utils_DecodeBcd(data, len, iccid, sizeof(pa_sim_CardId_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function get the International Mobile Subscriber Identity (IMSI).
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_GetIMSI
+(
+    pa_sim_Imsi_t imsi   ///< [OUT] IMSI value
+)
+{
+    uint8_t     data[EF_DATA_MAX_BYTES];
+    size_t      len = sizeof(data);
+    le_result_t res;
+
+    if (!imsi)
+    {
+        LE_DEBUG("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    res = pa_sim_local_ReadEf(PA_SIM_EF_IMSI, data, &len);
+    if ((LE_OK != res) || (LE_OK != DecodeImsi(data, len, imsi)))
+    {
+        LE_ERROR("Failed to read the IMSI");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function get the SIM Status.
+ *
+ * The state is served from the cache maintained by the unsolicited responses. AT+CPIN? is only
+ * sent to resynchronize an unknown or busy state, at most once per SIM_STATE_RESYNC_PERIOD_MS.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_GetState
+(
+    le_sim_States_t* statePtr    ///< [OUT] SIM state
+)
+{
+    le_clk_Time_t resyncPeriod = { .sec  = SIM_STATE_RESYNC_PERIOD_MS / 1000,
+                                   .usec = (SIM_STATE_RESYNC_PERIOD_MS % 1000) * 1000 };
+    le_result_t   res          = LE_OK;
+
+    if (!statePtr)
+    {
+        LE_DEBUG("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    if (   ((LE_SIM_STATE_UNKNOWN == CurrentSlotPtr->state)
+            || (LE_SIM_BUSY == CurrentSlotPtr->state))
+        && !le_clk_GreaterThan(le_clk_Add(SimStateResyncTime, resyncPeriod),
+                               le_clk_GetRelativeTime()))
+    {
+        res = ResyncSimState();
+    }
+
+    *statePtr = CurrentSlotPtr->state;
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the cached SIM state so that the next pa_sim_GetState() resynchronizes it.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_InvalidateState
+(
+    void
+)
+{
+    CurrentSlotPtr->state = LE_SIM_STATE_UNKNOWN;
+    SimStateResyncTime = (le_clk_Time_t){ 0 };
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an elementary file of the SIM.
+ *
+ * The content is served from the cache of the inserted card when available.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_NOT_FOUND     The file does not exist on the card.
+ * @return LE_OVERFLOW      The file does not fit in the buffer.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_local_ReadEf
+(
+    pa_sim_local_Ef_t ef,       ///< [IN] Elementary file
+    uint8_t*          dataPtr,  ///< [OUT] File content
+    size_t*           lenPtr    ///< [IN/OUT] File content length
+)
+{
+    EfCacheEntry_t* entryPtr;
+
+    if ((ef >= PA_SIM_EF_MAX) || (!dataPtr) || (!lenPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (!CurrentSlotPtr->isVerified)
+    {
+        return ReadEfFromCard(ef, dataPtr, lenPtr);
+    }
+
+    entryPtr = &CurrentSlotPtr->efCache[ef];
+    if (!entryPtr->isValid)
+    {
+        le_result_t res = FillEfCacheEntry(ef, entryPtr);
+
+        if (!entryPtr->isValid)
+        {
+            return res;
+        }
+    }
+
+    if (LE_OK != entryPtr->result)
+    {
+        return entryPtr->result;
+    }
+
+    if (entryPtr->len > *lenPtr)
+    {
+        return LE_OVERFLOW;
+    }
+
+    memcpy(dataPtr, entryPtr->data, entryPtr->len);
+    *lenPtr = entryPtr->len;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the elementary files cache, e.g. after a SIM refresh or a file update. The files are
+ * read again from the card on their next access.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_InvalidateEfCache
+(
+    void
+)
+{
+    uint32_t ef;
+
+    LE_DEBUG("Invalidate the SIM cache");
+
+    // Keep the ICCID: the card is the same, only its content changed
+    for (ef = 0; ef < PA_SIM_EF_MAX; ef++)
+    {
+        if (PA_SIM_EF_ICCID != ef)
+        {
+            CurrentSlotPtr->efCache[ef].isValid = false;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the SIM slot selection command of the modem and read the selected slot.
+ *
+ * Only one slot is available when the selected slot cannot be read.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_SetSlotSelectProfile
+(
+    pa_sim_SlotSelectProfile_t profile      ///< [IN] The slot selection command
+)
+{
+    const SlotSelectCommand_t* commandPtr;
+    char                       responseStr[PA_AT_LOCAL_SHORT_SIZE] = {0};
+    le_sim_Id_t                simId = LE_SIM_EXTERNAL_SLOT_1;
+    int                        slot;
+
+    if ((profile < PA_SIM_SLOT_SELECT_NONE) || (profile >= NUM_ARRAY_MEMBERS(SlotSelectCommands)))
+    {
+        LE_ERROR("Bad slot selection command %d", profile);
+        return;
+    }
+
+    commandPtr = &SlotSelectCommands[profile];
+    SlotSelectProfile = PA_SIM_SLOT_SELECT_NONE;
+
+    if (PA_SIM_SLOT_SELECT_NONE == profile)
+    {
+        LE_DEBUG("Single SIM");
+    }
+    else if (LE_OK != pa_utils_GetATIntermediateResponse(commandPtr->getCmdPtr,
+                                                         commandPtr->prefixPtr,
+                                                         responseStr,
+                                                         sizeof(responseStr)))
+    {
+        LE_WARN("Slot selection not supported, single SIM");
+    }
+    else
+    {
+        slot = atoi(responseStr + strlen(commandPtr->prefixPtr));
+        if ((slot < 0) || (slot >= MAX_SIM_SLOTS) || (LE_SIM_ID_MAX == commandPtr->slots[slot]))
+        {
+            LE_ERROR("Unexpected selected slot %d, single SIM", slot);
+        }
+        else
+        {
+            SlotSelectProfile = profile;
+            simId = commandPtr->slots[slot];
+        }
+    }
+
+    if (simId != UimSelect)
+    {
+        SwitchSlot(simId);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the cached identity of the card of a SIM slot, selected or not, without any AT command.
+ *
+ * The ICCID and IMSI are set to an empty string when they are not known.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_NOT_FOUND     The card of the slot has never been seen.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_local_GetSlotInfo
+(
+    le_sim_Id_t      simId,     ///< [IN] SIM identifier
+    pa_sim_CardId_t  iccid,     ///< [OUT] ICCID value
+    pa_sim_Imsi_t    imsi,      ///< [OUT] IMSI value
+    le_sim_States_t* statePtr   ///< [OUT] Last known SIM state
+)
+{
+    const SimSlot_t*      slotPtr;
+    const EfCacheEntry_t* entryPtr;
+
+    if ((simId >= LE_SIM_ID_MAX) || (!iccid) || (!imsi) || (!statePtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    slotPtr = &SimSlots[simId];
+    if (LE_SIM_STATE_UNKNOWN == slotPtr->lastKnownState)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    iccid[0] = '\0';
+    imsi[0] = '\0';
+    *statePtr = (slotPtr == CurrentSlotPtr) ? slotPtr->state : slotPtr->lastKnownState;
+
+    entryPtr = &slotPtr->efCache[PA_SIM_EF_ICCID];
+    if ((entryPtr->isValid) && (LE_OK == entryPtr->result)
+        && (LE_OK != pa_sim_utils_DecodeBcd(entryPtr->data, entryPtr->len,
+                                            iccid, sizeof(pa_sim_CardId_t))))
+    {
+        iccid[0] = '\0';
+    }
+
+    entryPtr = &slotPtr->efCache[PA_SIM_EF_IMSI];
+    if ((entryPtr->isValid) && (LE_OK == entryPtr->result)
+        && (LE_OK != DecodeImsi(entryPtr->data, entryPtr->len, imsi)))
+    {
+        imsi[0] = '\0';
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register a handler for new SIM state notification handling.
+ *
+ * @return A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_event_HandlerRef_t pa_sim_AddNewStateHandler
+(
+    pa_sim_NewStateHdlrFunc_t handler ///< [IN] The handler function.
+)
+{
+    LE_DEBUG("Set new SIM State handler");
+
+    LE_FATAL_IF(handler == NULL, "New SIM State handler is NULL");
+
+    return (le_event_AddHandler("NewSIMStateHandler",
+                                EventNewSimStateId,
+                                (le_event_HandlerFunc_t) handler));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to unregister the handler for new SIM state notification handling.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_RemoveNewStateHandler
+(
+    le_event_HandlerRef_t handlerRef
+)
+{
+    le_event_RemoveHandler(handlerRef);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function enter the PIN code.
+ *
+ * @return LE_FAULT         The function failed to enter the value.
+ * @return LE_TIMEOUT       No response was received from the SIM card.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_EnterPIN
+(
+    pa_sim_PinType_t   type,  ///< [IN] pin type
+    const pa_sim_Pin_t pin    ///< [IN] pin code
+)
+{
+    char                 command[PA_AT_LOCAL_SHORT_SIZE];
+    le_result_t          res    = LE_OK;
+
+    snprintf(command,PA_AT_LOCAL_SHORT_SIZE,"AT+CPIN=%s",pin);
+
+    res = pa_utils_SendATCommandOK(command);
+    pa_sim_local_InvalidateState();
+    pa_sim_local_RefreshRemainingAttempts();
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register a handler for SIM Toolkit event notification handling.
+ *
+ * @return A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_event_HandlerRef_t pa_sim_AddSimToolkitEventHandler
+(
+    pa_sim_SimToolkitEventHdlrFunc_t handler,    ///< [IN] The handler function.
+    void*                            contextPtr  ///< [IN] The context to be given to the handler.
+)
+{
+    le_event_HandlerRef_t handlerRef;
+
+    LE_FATAL_IF(handler == NULL, "SIM Toolkit handler is NULL");
+
+    handlerRef = le_event_AddHandler("StkEventHandler",
+                                     EventStkId,
+                                     (le_event_HandlerFunc_t) handler);
+    le_event_SetContextPtr(handlerRef, contextPtr);
+
+    return handlerRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to unregister the handler for SIM Toolkit event notification
+ * handling.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_RemoveSimToolkitEventHandler
+(
+    le_event_HandlerRef_t handlerRef
+)
+{
+    le_event_RemoveHandler(handlerRef);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve the last SIM Toolkit status.
+ *
+ * @return
+ *      - LE_OK             On success.
+ *      - LE_BAD_PARAMETER  A parameter is invalid.
+ *      - LE_UNSUPPORTED    The platform does not support this operation.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_GetLastStkStatus
+(
+    pa_sim_StkEvent_t*  stkStatus  ///< [OUT] last SIM Toolkit event status
+)
+{
+    if (NULL == stkStatus)
     {
-        ReportState(UimSelect,*statePtr);
+        return LE_BAD_PARAMETER;
     }
 
-    le_atClient_Delete(cmdRef);
-    return res;
+    *stkStatus = LastStkEvent;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to register a handler for new SIM state notification handling.
- *
- * @return A handler reference, which is only needed for later removal of the handler.
+ * Append a binary buffer encoded in hexadecimal, between quotes, at the end of an AT command.
  *
- * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ * @return LE_OK            The function succeeded.
+ * @return LE_OVERFLOW      The command buffer is too small.
  */
 //--------------------------------------------------------------------------------------------------
-le_event_HandlerRef_t pa_sim_AddNewStateHandler
+static le_result_t AppendHexParameter
 (
-    pa_sim_NewStateHdlrFunc_t handler ///< [IN] The handler function.
+    char*          commandPtr,  ///< [IN/OUT] AT command
+    size_t         commandSize, ///< [IN] AT command buffer size
+    const uint8_t* dataPtr,     ///< [IN] Data to encode
+    size_t         dataLen      ///< [IN] Data length in bytes
 )
 {
-    LE_DEBUG("Set new SIM State handler");
+    size_t  len = strlen(commandPtr);
+    int32_t hexLen;
 
-    LE_FATAL_IF(handler == NULL, "New SIM State handler is NULL");
+    // Opening quote, hexadecimal string, closing quote and null terminator
+    if ((len + 2 * dataLen + 3) > commandSize)
+    {
+        return LE_OVERFLOW;
+    }
 
-    return (le_event_AddHandler("NewSIMStateHandler",
-                                EventNewSimStateId,
-                                (le_event_HandlerFunc_t) handler));
+    commandPtr[len++] = '"';
+    hexLen = le_hex_BinaryToString(dataPtr, dataLen, commandPtr + len, commandSize - len);
+    if (hexLen < 0)
+    {
+        return LE_OVERFLOW;
+    }
+    len += hexLen;
+    commandPtr[len++] = '"';
+    commandPtr[len] = NULL_CHAR;
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to unregister the handler for new SIM state notification handling.
+ * Decode the "<length>,"<response>"" parameters of a +CSIM intermediate response.
  *
- * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ * @return LE_OK            The function succeeded.
+ * @return LE_OVERFLOW      The response buffer is too small.
+ * @return LE_FAULT         The response is malformed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_RemoveNewStateHandler
+static le_result_t DecodeApduResponse
 (
-    le_event_HandlerRef_t handlerRef
+    char*     responseStr,  ///< [IN] Intermediate response, modified by the function
+    uint8_t*  respPtr,      ///< [OUT] Response APDU
+    size_t*   lenPtr        ///< [IN/OUT] Response APDU length in bytes
 )
 {
-    le_event_RemoveHandler(handlerRef);
+    char*   hexPtr;
+    int32_t len;
+
+    if (pa_utils_CountAndIsolateLineParameters(responseStr) < 3)
+    {
+        LE_ERROR("Malformed response");
+        return LE_FAULT;
+    }
+
+    hexPtr = pa_utils_IsolateLineParameter(responseStr, 3);
+    pa_utils_RemoveQuotationString(hexPtr);
+
+    if ((strlen(hexPtr) / 2) > *lenPtr)
+    {
+        LE_ERROR("Response of %zu bytes does not fit in %zu bytes", strlen(hexPtr) / 2, *lenPtr);
+        return LE_OVERFLOW;
+    }
+
+    len = le_hex_StringToBinary(hexPtr, strlen(hexPtr), respPtr, *lenPtr);
+    if (len < 0)
+    {
+        LE_ERROR("Response cannot be converted");
+        return LE_FAULT;
+    }
 
+    *lenPtr = len;
     return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function enter the PIN code.
+ * Send an APDU with AT+CSIM, on the basic channel or on the logical channel selected by its class
+ * byte.
  *
- * @return LE_FAULT         The function failed to enter the value.
- * @return LE_TIMEOUT       No response was received from the SIM card.
  * @return LE_OK            The function succeeded.
+ * @return LE_OVERFLOW      The APDU or its response does not fit in the AT buffers.
+ * @return LE_FAULT         The function failed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_EnterPIN
+static le_result_t TransmitApdu
 (
-    pa_sim_PinType_t   type,  ///< [IN] pin type
-    const pa_sim_Pin_t pin    ///< [IN] pin code
+    const uint8_t* apduPtr,    ///< [IN] APDU message buffer
+    uint32_t       apduLen,    ///< [IN] APDU message length in bytes
+    uint8_t*       respPtr,    ///< [OUT] APDU message response
+    size_t*        lenPtr      ///< [IN/OUT] APDU message response length in bytes
 )
 {
-    char                 command[PA_AT_LOCAL_SHORT_SIZE];
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-
-    snprintf(command,PA_AT_LOCAL_SHORT_SIZE,"AT+CPIN=%s",pin);
+    char        command[LE_ATDEFS_COMMAND_MAX_BYTES];
+    char        responseStr[LE_ATDEFS_RESPONSE_MAX_BYTES] = {0};
+    le_result_t res;
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        command,
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
+    snprintf(command, sizeof(command), "AT+CSIM=%" PRIu32 ",", 2 * apduLen);
 
-    if (res != LE_OK)
+    res = AppendHexParameter(command, sizeof(command), apduPtr, apduLen);
+    if (LE_OK != res)
     {
-        LE_ERROR("Failed to send the command");
+        LE_ERROR("APDU of %" PRIu32 " bytes is too long", apduLen);
         return res;
     }
 
-    le_atClient_Delete(cmdRef);
-    return res;
+    res = pa_utils_GetATIntermediateResponse(command,
+                                             "+CSIM:",
+                                             responseStr,
+                                             sizeof(responseStr));
+    if (LE_OK != res)
+    {
+        LE_ERROR("Failed to send the APDU");
+        return LE_FAULT;
+    }
+
+    return DecodeApduResponse(responseStr, respPtr, lenPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to register a handler for SIM Toolkit event notification handling.
- *
- * @return A handler reference, which is only needed for later removal of the handler.
+ * Find a logical channel by its channel number.
  *
- * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ * @return the logical channel, NULL if not found
  */
 //--------------------------------------------------------------------------------------------------
-le_event_HandlerRef_t pa_sim_AddSimToolkitEventHandler
+static LogicalChannel_t* FindLogicalChannel
 (
-    pa_sim_SimToolkitEventHdlrFunc_t handler,    ///< [IN] The handler function.
-    void*                            contextPtr  ///< [IN] The context to be given to the handler.
+    uint8_t channel  ///< [IN] Channel number
 )
 {
-    /**
-     * It is safe to return a fake reference as this functionality
-     * is not used on all platform, but the function is invoked in
-     * le_sim_Init()
-     */
-    return (le_event_HandlerRef_t) 0x01;
+    uint32_t i;
+
+    for (i = 0; i < MAX_LOGICAL_CHANNELS; i++)
+    {
+        if ((LogicalChannels[i].isOpen) && (LogicalChannels[i].channel == channel))
+        {
+            return &LogicalChannels[i];
+        }
+    }
+
+    return NULL;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to unregister the handler for SIM Toolkit event notification
- * handling.
+ * Close a logical channel on the SIM card and release its entry.
  *
- * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ * @return LE_OK            The function succeeded.
+ * @return LE_FAULT         The function failed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_RemoveSimToolkitEventHandler
+static le_result_t ReleaseLogicalChannel
 (
-    le_event_HandlerRef_t handlerRef
+    LogicalChannel_t* channelPtr  ///< [IN] Logical channel
 )
 {
-    return LE_FAULT;
+    // MANAGE CHANNEL close
+    uint8_t     apdu[] = { 0x00, 0x70, 0x80, channelPtr->channel, 0x00 };
+    uint8_t     resp[2];
+    size_t      respLen = sizeof(resp);
+    le_result_t res;
+
+    res = TransmitApdu(apdu, sizeof(apdu), resp, &respLen);
+    if ((LE_OK == res) && ((respLen != 2) || (0x90 != resp[0]) || (0x00 != resp[1])))
+    {
+        res = LE_FAULT;
+    }
+
+    memset(channelPtr, 0, sizeof(LogicalChannel_t));
+    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Retrieve the last SIM Toolkit status.
+ * Get a free logical channel entry.
  *
- * @return
- *      - LE_OK             On success.
- *      - LE_BAD_PARAMETER  A parameter is invalid.
- *      - LE_UNSUPPORTED    The platform does not support this operation.
+ * @return the logical channel entry, NULL if all channels are open
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_GetLastStkStatus
+static LogicalChannel_t* GetFreeLogicalChannel
 (
-    pa_sim_StkEvent_t*  stkStatus  ///< [OUT] last SIM Toolkit event status
+    void
 )
 {
-    if (NULL == stkStatus)
+    uint32_t i;
+
+    for (i = 0; i < MAX_LOGICAL_CHANNELS; i++)
     {
-        return LE_BAD_PARAMETER;
+        if (!LogicalChannels[i].isOpen)
+        {
+            return &LogicalChannels[i];
+        }
     }
 
-    return LE_UNSUPPORTED;
+    return NULL;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to open a logical channel on the SIM card.
  *
+ * A MANAGE CHANNEL command is sent with AT+CSIM.
+ *
  * @return
  *      - LE_OK on success
  *      - LE_FAULT for unexpected error
@@ -576,7 +1812,36 @@ le_result_t pa_sim_OpenLogicalChannel
     uint8_t* channelPtr  ///< [OUT] channel number
 )
 {
-    return LE_FAULT;
+    // MANAGE CHANNEL open, the card assigns the channel number
+    uint8_t           apdu[] = { 0x00, 0x70, 0x00, 0x00, 0x01 };
+    uint8_t           resp[3];
+    size_t            respLen = sizeof(resp);
+    LogicalChannel_t* logicalChannelPtr;
+
+    if (!channelPtr)
+    {
+        return LE_FAULT;
+    }
+
+    logicalChannelPtr = GetFreeLogicalChannel();
+    if (!logicalChannelPtr)
+    {
+        LE_ERROR("No logical channel available");
+        return LE_FAULT;
+    }
+
+    if ((LE_OK != TransmitApdu(apdu, sizeof(apdu), resp, &respLen))
+        || (3 != respLen) || (0x90 != resp[1]) || (0x00 != resp[2]))
+    {
+        LE_ERROR("Failed to open a logical channel");
+        return LE_FAULT;
+    }
+
+    logicalChannelPtr->isOpen = true;
+    logicalChannelPtr->channel = resp[0];
+
+    *channelPtr = resp[0];
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -593,7 +1858,21 @@ le_result_t pa_sim_CloseLogicalChannel
     uint8_t channel  ///< [IN] channel number
 )
 {
-    return LE_FAULT;
+    LogicalChannel_t* logicalChannelPtr = FindLogicalChannel(channel);
+
+    if (!logicalChannelPtr)
+    {
+        LE_ERROR("Logical channel %d is not open", channel);
+        return LE_FAULT;
+    }
+
+    if (LE_OK != ReleaseLogicalChannel(logicalChannelPtr))
+    {
+        LE_ERROR("Failed to close logical channel %d", channel);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -615,7 +1894,19 @@ le_result_t pa_sim_SendApdu
     size_t*        lenPtr   ///< [IN,OUT] APDU message response length in bytes.
 )
 {
-    return LE_FAULT;
+    if ((!apduPtr) || (!apduLen) || (!respPtr) || (!lenPtr))
+    {
+        return LE_FAULT;
+    }
+
+    // The logical channel is selected by the class byte of the APDU
+    if ((channel) && (!FindLogicalChannel(channel)))
+    {
+        LE_ERROR("Logical channel %d is not open", channel);
+        return LE_FAULT;
+    }
+
+    return TransmitApdu(apduPtr, apduLen, respPtr, lenPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -648,105 +1939,189 @@ le_result_t pa_sim_SendCommand
     size_t*          responseNumElementsPtr ///< [IN/OUT] Size of response
 )
 {
-    return LE_UNSUPPORTED;
-}
+    // AT+CRSM <command> values, indexed by le_sim_Command_t
+    static const int crsmCommands[] =
+    {
+        178,    // LE_SIM_READ_RECORD
+        176,    // LE_SIM_READ_BINARY
+        220,    // LE_SIM_UPDATE_RECORD
+        214,    // LE_SIM_UPDATE_BINARY
+        203,    // LE_SIM_RETRIEVE_DATA
+    };
+    char        atCommand[LE_ATDEFS_COMMAND_MAX_BYTES];
+    char        responseStr[LE_ATDEFS_RESPONSE_MAX_BYTES] = {0};
+    uint32_t    nbParam;
+    le_result_t res;
+
+    if (((uint32_t) command >= NUM_ARRAY_MEMBERS(crsmCommands)) || (!fileIdentifierPtr)
+        || (!sw1Ptr) || (!sw2Ptr) || (!responsePtr) || (!responseNumElementsPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * This function must be called to reset the SIM.
- *
- * @return
- *      - LE_OK          On success.
- *      - LE_FAULT       On failure.
- *      - LE_UNSUPPORTED The platform does not support this operation.
- */
-//--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_Reset
-(
-    void
-)
-{
-    return LE_UNSUPPORTED;
-}
+    snprintf(atCommand, sizeof(atCommand), "AT+CRSM=%d,%" PRIu32 ",%d,%d,%d",
+             crsmCommands[command], pa_utils_ConvertHexStringToUInt32(fileIdentifierPtr),
+             p1, p2, p3);
 
-//--------------------------------------------------------------------------------------------------
-/**
- * This function must be called to write the FPLMN list into the modem.
- *
- * @return
- *      - LE_OK             On success.
- *      - LE_FAULT          On failure.
- *      - LE_BAD_PARAMETER  A parameter is invalid.
- *      - LE_UNSUPPORTED    The platform does not support this operation.
- */
-//--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_WriteFPLMNList
-(
-    le_dls_List_t *FPLMNListPtr ///< [IN] List of FPLMN operators
-)
-{
-    return LE_UNSUPPORTED;
-}
+    if ((dataPtr && dataNumElements) || (pathPtr && pathPtr[0]))
+    {
+        strncat(atCommand, ",", sizeof(atCommand) - strlen(atCommand) - 1);
+        res = AppendHexParameter(atCommand, sizeof(atCommand), dataPtr, dataNumElements);
+        if (LE_OK != res)
+        {
+            return res;
+        }
+
+        if (pathPtr && pathPtr[0])
+        {
+            if ((strlen(atCommand) + strlen(pathPtr) + 4) > sizeof(atCommand))
+            {
+                return LE_OVERFLOW;
+            }
+            snprintf(atCommand + strlen(atCommand), sizeof(atCommand) - strlen(atCommand),
+                     ",\"%s\"", pathPtr);
+        }
+    }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * This function must be called to get the number of FPLMN operators present in the list.
- *
- * @return
- *      - LE_OK             On success.
- *      - LE_FAULT          On failure.
- *      - LE_BAD_PARAMETER  A parameter is invalid.
- *      - LE_UNSUPPORTED    The platform does not support this operation.
- */
-//--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_CountFPLMNOperators
-(
-    uint32_t*  nbItemPtr     ///< [OUT] number of FPLMN operator found if success.
-)
-{
-    return LE_UNSUPPORTED;
+    res = pa_utils_GetATIntermediateResponse(atCommand, "+CRSM:", responseStr,
+                                             sizeof(responseStr));
+    if (LE_OK != res)
+    {
+        LE_ERROR("Failed to send the SIM command");
+        return LE_FAULT;
+    }
+
+    // +CRSM: <sw1>,<sw2>[,<response>]
+    nbParam = pa_utils_CountAndIsolateLineParameters(responseStr);
+    if (nbParam < 3)
+    {
+        LE_ERROR("Malformed response");
+        return LE_FAULT;
+    }
+
+    *sw1Ptr = (uint8_t) atoi(pa_utils_IsolateLineParameter(responseStr, 2));
+    *sw2Ptr = (uint8_t) atoi(pa_utils_IsolateLineParameter(responseStr, 3));
+
+    if ((0x94 == *sw1Ptr) || ((0x6A == *sw1Ptr) && (0x82 == *sw2Ptr)))
+    {
+        LE_DEBUG("File %s not found", fileIdentifierPtr);
+        return LE_NOT_FOUND;
+    }
+
+    if (nbParam >= 4)
+    {
+        char*   hexPtr = pa_utils_IsolateLineParameter(responseStr, 4);
+        int32_t len;
+
+        pa_utils_RemoveQuotationString(hexPtr);
+        if ((strlen(hexPtr) / 2) > *responseNumElementsPtr)
+        {
+            return LE_OVERFLOW;
+        }
+
+        len = le_hex_StringToBinary(hexPtr, strlen(hexPtr), responsePtr,
+                                    *responseNumElementsPtr);
+        if (len < 0)
+        {
+            LE_ERROR("Response cannot be converted");
+            return LE_FAULT;
+        }
+        *responseNumElementsPtr = len;
+    }
+    else
+    {
+        *responseNumElementsPtr = 0;
+    }
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to read the FPLMN list.
+ * This function must be called to confirm a SIM Toolkit command.
+ *
+ * The TERMINAL RESPONSE of the pending proactive command is sent with AT+CUSATT.
  *
  * @return
- *      - LE_OK             On success.
- *      - LE_NOT_FOUND      If no FPLMN network is available.
- *      - LE_BAD_PARAMETER  A parameter is invalid.
- *      - LE_UNSUPPORTED    The platform does not support this operation.
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_ReadFPLMNOperators
+le_result_t pa_sim_ConfirmSimToolkitCommand
 (
-    pa_sim_FPLMNOperator_t* FPLMNOperatorPtr,   ///< [OUT] FPLMN operators.
-    uint32_t* FPLMNOperatorCountPtr             ///< [IN/OUT] FPLMN operator count.
+    bool  confirmation  ///< [IN] true to accept, false to reject
 )
 {
-    return LE_UNSUPPORTED;
+    // Command details, device identities (terminal to UICC) and result
+    uint8_t     response[] = { 0x81, 0x03, 0x00, 0x00, 0x00,
+                               0x82, 0x02, 0x82, 0x81,
+                               0x83, 0x01, 0x00, 0x00 };
+    size_t      responseLen = sizeof(response) - 1;
+    char        command[LE_ATDEFS_COMMAND_MAX_BYTES] = "AT+CUSATT=";
+    le_result_t res;
+
+    if (!IsStkCommandPending)
+    {
+        LE_ERROR("No SIM Toolkit command to confirm");
+        return LE_FAULT;
+    }
+
+    memcpy(&response[2], PendingStkCommand, sizeof(PendingStkCommand));
+
+    if (!confirmation)
+    {
+        if (STK_CMD_REFRESH == PendingStkCommand[1])
+        {
+            // Terminal currently unable to process command, no specific cause
+            response[10] = 0x02;
+            response[11] = 0x20;
+            response[12] = 0x00;
+            responseLen = sizeof(response);
+        }
+        else
+        {
+            // User did not accept the proactive command
+            response[11] = 0x22;
+        }
+    }
+
+    res = AppendHexParameter(command, sizeof(command), response, responseLen);
+    if (LE_OK == res)
+    {
+        res = pa_utils_SendATCommandOK(command);
+    }
+
+    IsStkCommandPending = false;
+
+    if (STK_CMD_REFRESH == PendingStkCommand[1])
+    {
+        if ((LE_OK != res) || (!confirmation))
+        {
+            IsRefreshPending = false;
+        }
+        ReportStkEvent(LE_SIM_REFRESH, LastStkEvent.stkRefreshMode,
+                       ((LE_OK == res) && confirmation) ? LE_SIM_STAGE_END_WITH_SUCCESS :
+                                                          LE_SIM_STAGE_END_WITH_FAILURE);
+    }
+
+    return (LE_OK == res) ? LE_OK : LE_FAULT;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Retrieve the last SIM Toolkit status.
+ * This function must be called to reset the SIM.
  *
  * @return
- *      - LE_OK             On success.
- *      - LE_BAD_PARAMETER  A parameter is invalid.
- *      - LE_UNSUPPORTED    The platform does not support this operation.
+ *      - LE_OK          On success.
+ *      - LE_FAULT       On failure.
+ *      - LE_UNSUPPORTED The platform does not support this operation.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_GetLastStkStatus
+le_result_t pa_sim_Reset
 (
-    pa_sim_StkEvent_t*  stkStatus  ///< [OUT] last SIM Toolkit event status
+    void
 )
 {
-    if (NULL == stkStatus)
-    {
-        return LE_BAD_PARAMETER;
-    }
-
     return LE_UNSUPPORTED;
 }
 
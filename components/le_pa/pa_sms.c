@@ -65,6 +65,336 @@ static le_event_Id_t          NewSmsEventId;
 //--------------------------------------------------------------------------------------------------
 static le_event_HandlerRef_t  SmsHandlerRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of sent messages waiting for a status report
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_DELIVERY_TRACKING_MAX       16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time in seconds after which a sent message without status report is considered as expired
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_DELIVERY_TRACKING_TIMEOUT   3600
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TP-Message-Type-Indicator of an SMS-STATUS-REPORT (3GPP TS 23.040 9.2.3.1)
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_TP_MTI_MASK                 0x03
+#define SMS_TP_MTI_STATUS_REPORT        0x02
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a TP-Service-Centre-Time-Stamp or TP-Discharge-Time field
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_TP_TIMESTAMP_BYTES          7
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TP-Status ranges (3GPP TS 23.040 9.2.3.15)
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_TP_ST_TEMPORARY_ERROR       0x20
+#define SMS_TP_ST_PERMANENT_ERROR       0x40
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TP-Status used in the delivery report of an expired message
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_TP_ST_UNKNOWN               0xFF
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sent message waiting for its status report
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool          inUse;                                        ///< Entry is used
+    uint8_t       msgRef;                                       ///< TP-MR of the message
+    char          destination[LE_MDMDEFS_PHONE_NUM_MAX_BYTES];  ///< Destination address
+    le_clk_Time_t sendTime;                                     ///< Submission time
+}
+SentMsg_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sent messages correlation table
+ */
+//--------------------------------------------------------------------------------------------------
+static SentMsg_t SentMsgTable[SMS_DELIVERY_TRACKING_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delivery report event identifier
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t          DeliveryReportEventId;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set when a +CDS: header has been received and its PDU line is expected
+ */
+//--------------------------------------------------------------------------------------------------
+static bool                   CdsPduExpected = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of preferred message storages managed by AT+CPMS (mem1, mem2, mem3)
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_MEM_NB              3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a message storage name ("SM", "ME", ...)
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_MEM_NAME_BYTES      3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preferred message storages
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    SMS_MEM_READ    = 0,   ///< mem1: messages read and deleted
+    SMS_MEM_WRITE   = 1,   ///< mem2: messages written and sent
+    SMS_MEM_RECEIVE = 2,   ///< mem3: received messages
+}
+SmsMem_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Current preferred message storages, an empty name means the storage is not known
+ */
+//--------------------------------------------------------------------------------------------------
+static char CurrentMem[SMS_MEM_NB][SMS_MEM_NAME_BYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function converts a message storage into its AT+CPMS name.
+ *
+ * @return The storage name, NULL if the storage is not supported.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* StorageToMem
+(
+    pa_sms_Storage_t storage    ///< [IN] SMS Storage
+)
+{
+    switch (storage)
+    {
+        case PA_SMS_STORAGE_SIM:
+            return "SM";
+        case PA_SMS_STORAGE_NV:
+            return "ME";
+        default:
+            return NULL;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function converts an AT+CPMS storage name into a message storage.
+ *
+ * @return The SMS storage.
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_sms_Storage_t MemToStorage
+(
+    const char* memPtr          ///< [IN] Storage name
+)
+{
+    if (strcmp(memPtr, "SM") == 0)
+    {
+        return PA_SMS_STORAGE_SIM;
+    }
+    else if (strcmp(memPtr, "ME") == 0)
+    {
+        return PA_SMS_STORAGE_NV;
+    }
+
+    return PA_SMS_STORAGE_UNKNOWN;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function reads the preferred message storages from the modem into the cache.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_TIMEOUT       No response was received from the Modem.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadPreferredMem
+(
+    void
+)
+{
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res    = LE_FAULT;
+    char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    int                  i;
+
+    // AT+CPMS?
+    // +CPMS: "SM",1,20,"SM",1,20,"SM",1,20
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        "AT+CPMS?",
+                                        "+CPMS:",
+                                        "OK|ERROR|+CME ERROR:|+CMS ERROR:",
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
+    {
+        LE_ERROR("Failed to send the command");
+        return res;
+    }
+
+    res = le_atClient_GetFinalResponse(cmdRef,
+                                       finalResponse,
+                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
+    if ((res != LE_OK) || (strcmp(finalResponse,"OK") != 0))
+    {
+        LE_ERROR("Final response is not OK");
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
+
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
+                                                   intermediateResponse,
+                                                   LE_ATDEFS_RESPONSE_MAX_BYTES);
+    le_atClient_Delete(cmdRef);
+
+    if (res != LE_OK)
+    {
+        LE_ERROR("Failed to get the intermediateResponse");
+        return res;
+    }
+
+    if (pa_utils_CountAndIsolateLineParameters(intermediateResponse) < 2 + 3*(SMS_MEM_NB-1))
+    {
+        LE_ERROR("this pattern is not expected");
+        return LE_FAULT;
+    }
+
+    // Storage names are the 2nd, 5th and 8th parameters
+    for (i = 0; i < SMS_MEM_NB; i++)
+    {
+        char* memPtr = pa_utils_IsolateLineParameter(intermediateResponse, 2 + 3*i);
+
+        pa_utils_RemoveQuotationString(memPtr);
+        le_utf8_Copy(CurrentMem[i], memPtr, SMS_MEM_NAME_BYTES, NULL);
+    }
+
+    LE_DEBUG("Preferred storages: %s, %s, %s",
+             CurrentMem[SMS_MEM_READ], CurrentMem[SMS_MEM_WRITE], CurrentMem[SMS_MEM_RECEIVE]);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sends AT+CPMS with the given storage names and updates the cache.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_TIMEOUT       No response was received from the Modem.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WritePreferredMem
+(
+    const char* memPtr[],   ///< [IN] Storage names, up to SMS_MEM_NB
+    int         memNb       ///< [IN] Number of storage names
+)
+{
+    char                 command[LE_ATDEFS_COMMAND_MAX_BYTES];
+    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res    = LE_FAULT;
+    int                  i;
+
+    snprintf(command, LE_ATDEFS_COMMAND_MAX_BYTES, "AT+CPMS=\"%s\"", memPtr[0]);
+    for (i = 1; i < memNb; i++)
+    {
+        strlcat(command, ",\"", sizeof(command));
+        strlcat(command, memPtr[i], sizeof(command));
+        strlcat(command, "\"", sizeof(command));
+    }
+
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        command,
+                                        "+CPMS:",
+                                        "OK|ERROR|+CME ERROR:|+CMS ERROR:",
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
+    {
+        LE_ERROR("Failed to send the command");
+        return res;
+    }
+
+    res = le_atClient_GetFinalResponse(cmdRef,
+                                       finalResponse,
+                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
+    le_atClient_Delete(cmdRef);
+
+    if ((res != LE_OK) || (strcmp(finalResponse,"OK") != 0))
+    {
+        LE_ERROR("Failed to set the preferred storage");
+        // The modem state is not known anymore
+        memset(CurrentMem, 0, sizeof(CurrentMem));
+        return LE_FAULT;
+    }
+
+    for (i = 0; i < memNb; i++)
+    {
+        le_utf8_Copy(CurrentMem[i], memPtr[i], SMS_MEM_NAME_BYTES, NULL);
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function selects the storage used to read, list and delete messages. AT+CPMS is only sent
+ * when the storage differs from the current one.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_TIMEOUT       No response was received from the Modem.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SelectReadStorage
+(
+    pa_sms_Storage_t storage    ///< [IN] SMS Storage
+)
+{
+    const char* memPtr = StorageToMem(storage);
+
+    if (NULL == memPtr)
+    {
+        // Keep the current storage
+        return LE_OK;
+    }
+
+    if (strcmp(CurrentMem[SMS_MEM_READ], memPtr) == 0)
+    {
+        return LE_OK;
+    }
+
+    LE_DEBUG("Switch read storage from '%s' to '%s'", CurrentMem[SMS_MEM_READ], memPtr);
+    return WritePreferredMem(&memPtr, 1);
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -73,18 +403,23 @@ static le_event_HandlerRef_t  SmsHandlerRef = NULL;
  *  parsing is "+CBMI: mem,index"
  *  parsing is "+CDSI: mem,index"
  *
- * @return true and index is filled.
+ * @return true and index and storage are filled.
  * @return false.
  */
 //--------------------------------------------------------------------------------------------------
 static bool GetSmsIndex
 (
-    char*     linePtr,    ///<  [IN] Line to parse
-    uint32_t* indexPtr    ///< [OUT] Message Reference
+    char*             linePtr,    ///<  [IN] Line to parse
+    uint32_t*         indexPtr,   ///< [OUT] Message Reference
+    pa_sms_Storage_t* storagePtr  ///< [OUT] Message storage
 )
 {
-    if (pa_utils_CountAndIsolateLineParameters(linePtr))
+    if (pa_utils_CountAndIsolateLineParameters(linePtr) >= 3)
     {
+        char* memPtr = pa_utils_IsolateLineParameter(linePtr,2);
+
+        pa_utils_RemoveQuotationString(memPtr);
+        *storagePtr = MemToStorage(memPtr);
         *indexPtr = atoi(pa_utils_IsolateLineParameter(linePtr,3));
 
         LE_DEBUG("SMS message index %d",*indexPtr);
@@ -107,23 +442,24 @@ static bool GetSmsIndex
 //--------------------------------------------------------------------------------------------------
 static bool CheckSmsUnsolicited
 (
-    char*     linePtr,      ///<  [IN] Line to parse
-    uint32_t* indexPtr      ///< [OUT] Message reference in memory
+    char*             linePtr,      ///<  [IN] Line to parse
+    uint32_t*         indexPtr,     ///< [OUT] Message reference in memory
+    pa_sms_Storage_t* storagePtr    ///< [OUT] Message storage
 )
 {
     bool res = false;
 
     if (FIND_STRING("+CMTI:",linePtr))
     {
-        res = GetSmsIndex(linePtr,indexPtr);
+        res = GetSmsIndex(linePtr,indexPtr,storagePtr);
     }
     else if (FIND_STRING("+CBMI:",linePtr))
     {
-        res = GetSmsIndex(linePtr,indexPtr);
+        res = GetSmsIndex(linePtr,indexPtr,storagePtr);
     }
     else if (FIND_STRING("+CDSI:",linePtr))
     {
-        res = GetSmsIndex(linePtr,indexPtr);
+        res = GetSmsIndex(linePtr,indexPtr,storagePtr);
     }
     else
     {
@@ -142,20 +478,327 @@ static bool CheckSmsUnsolicited
 //--------------------------------------------------------------------------------------------------
 static void ReportMsgIndex
 (
-    uint32_t  index  ///< [IN] message reference
+    uint32_t          index,    ///< [IN] message reference
+    pa_sms_Storage_t  storage   ///< [IN] message storage
 )
 {
     pa_sms_NewMessageIndication_t messageIndication = {0};
 
     messageIndication.msgIndex = index;
     messageIndication.protocol = PA_SMS_PROTOCOL_GSM; // @TODO Hard-coded
+    messageIndication.storage  = storage;
 
-    LE_DEBUG("Send new SMS Event with index %d in memory and protocol %d",
+    LE_DEBUG("Send new SMS Event with index %d in memory %d and protocol %d",
              messageIndication.msgIndex,
+             messageIndication.storage,
              messageIndication.protocol);
     le_event_Report(NewSmsEventId,&messageIndication, sizeof(messageIndication));
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function decodes an address field (TP-DA or TP-RA) of a PDU into a digit string. An address
+ * longer than the buffer is truncated, the same way for the sent messages and the status reports
+ * so that they still match.
+ *
+ * @return LE_OK            The address is decoded and fieldLenPtr is filled.
+ * @return LE_FAULT         The address field is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t DecodeAddress
+(
+    const uint8_t* pduPtr,      ///< [IN] Address field
+    uint32_t       length,      ///< [IN] Remaining length of the PDU
+    char*          addrPtr,     ///< [OUT] Decoded address
+    size_t         addrSize,    ///< [IN] Size of the address buffer
+    uint32_t*      fieldLenPtr  ///< [OUT] Length of the address field in bytes
+)
+{
+    static const char digits[] = "0123456789*#abc";
+    uint32_t          digitNb;
+    uint32_t          i;
+    uint32_t          pos = 0;
+
+    if (length < 2)
+    {
+        return LE_FAULT;
+    }
+
+    // Address-Length is the number of useful semi-octets, followed by Type-of-Address
+    digitNb = pduPtr[0];
+    *fieldLenPtr = 2 + (digitNb + 1) / 2;
+
+    if ((*fieldLenPtr > length) || (0 == addrSize))
+    {
+        return LE_FAULT;
+    }
+
+    if (digitNb >= addrSize)
+    {
+        LE_WARN("Address of %"PRIu32" digits truncated to %zu digits", digitNb, addrSize - 1);
+        digitNb = addrSize - 1;
+    }
+
+    for (i = 0; i < digitNb; i++)
+    {
+        uint8_t semiOctet = pduPtr[2 + i/2];
+
+        semiOctet = (i & 0x01) ? (semiOctet >> 4) : (semiOctet & 0x0F);
+        if (semiOctet < sizeof(digits) - 1)
+        {
+            addrPtr[pos++] = digits[semiOctet];
+        }
+    }
+    addrPtr[pos] = NULL_CHAR;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function reports the delivery of a tracked message to all registered handlers.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportDelivery
+(
+    const SentMsg_t*         sentMsgPtr,  ///< [IN] Tracked message
+    uint8_t                  status,      ///< [IN] TP-Status
+    pa_sms_DeliveryOutcome_t outcome,     ///< [IN] Delivery outcome
+    le_clk_Time_t            now          ///< [IN] Current relative time
+)
+{
+    pa_sms_DeliveryReport_t report;
+    le_clk_Time_t           latency = le_clk_Sub(now, sentMsgPtr->sendTime);
+
+    memset(&report, 0, sizeof(report));
+    report.msgRef    = sentMsgPtr->msgRef;
+    report.status    = status;
+    report.outcome   = outcome;
+    report.latencyMs = (uint32_t)(latency.sec * 1000 + latency.usec / 1000);
+    le_utf8_Copy(report.destination, sentMsgPtr->destination, sizeof(report.destination), NULL);
+
+    LE_DEBUG("Message %d to %s: status 0x%02X, outcome %d after %"PRIu32" ms",
+             report.msgRef, report.destination, report.status, report.outcome,
+             report.latencyMs);
+    le_event_Report(DeliveryReportEventId, &report, sizeof(report));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function releases the tracked messages whose status report did not arrive in time.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void PurgeExpiredSentMsg
+(
+    le_clk_Time_t now   ///< [IN] Current relative time
+)
+{
+    le_clk_Time_t timeout = { .sec = SMS_DELIVERY_TRACKING_TIMEOUT, .usec = 0 };
+    int           i;
+
+    for (i = 0; i < SMS_DELIVERY_TRACKING_MAX; i++)
+    {
+        if ((SentMsgTable[i].inUse) &&
+            (le_clk_GreaterThan(le_clk_Sub(now, SentMsgTable[i].sendTime), timeout)))
+        {
+            ReportDelivery(&SentMsgTable[i], SMS_TP_ST_UNKNOWN, PA_SMS_DELIVERY_EXPIRED, now);
+            SentMsgTable[i].inUse = false;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds a sent SMS-SUBMIT to the correlation table.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void TrackSentMsg
+(
+    uint8_t        msgRef,  ///< [IN] TP-MR returned by the modem
+    const uint8_t* pduPtr,  ///< [IN] Sent PDU, including the SMSC address
+    uint32_t       length   ///< [IN] Length of the PDU
+)
+{
+    char          destination[LE_MDMDEFS_PHONE_NUM_MAX_BYTES];
+    uint32_t      offset;
+    uint32_t      fieldLen;
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    SentMsg_t*    sentMsgPtr = &SentMsgTable[0];
+    int           i;
+
+    if (length < 1)
+    {
+        return;
+    }
+
+    // Skip SMSC address, first octet and TP-MR
+    offset = 1 + pduPtr[0] + 2;
+    if ((offset >= length) ||
+        (DecodeAddress(pduPtr + offset, length - offset, destination, sizeof(destination),
+                       &fieldLen) != LE_OK))
+    {
+        LE_WARN("Cannot decode the destination of message %d", msgRef);
+        return;
+    }
+
+    PurgeExpiredSentMsg(now);
+
+    // Use a free entry, or evict the oldest one
+    for (i = 0; i < SMS_DELIVERY_TRACKING_MAX; i++)
+    {
+        if (!SentMsgTable[i].inUse)
+        {
+            sentMsgPtr = &SentMsgTable[i];
+            break;
+        }
+        if (le_clk_GreaterThan(sentMsgPtr->sendTime, SentMsgTable[i].sendTime))
+        {
+            sentMsgPtr = &SentMsgTable[i];
+        }
+    }
+
+    if (sentMsgPtr->inUse)
+    {
+        LE_WARN("Correlation table full, message %d is no longer tracked", sentMsgPtr->msgRef);
+        ReportDelivery(sentMsgPtr, SMS_TP_ST_UNKNOWN, PA_SMS_DELIVERY_EXPIRED, now);
+    }
+
+    sentMsgPtr->inUse = true;
+    sentMsgPtr->msgRef = msgRef;
+    sentMsgPtr->sendTime = now;
+    le_utf8_Copy(sentMsgPtr->destination, destination, sizeof(sentMsgPtr->destination), NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function looks for the tracked message matching a status report. The TP-MR and the
+ * recipient address are matched first; as the network may return the recipient in another
+ * format, a unique TP-MR match is accepted otherwise.
+ *
+ * @return The tracked message, NULL if not found.
+ */
+//--------------------------------------------------------------------------------------------------
+static SentMsg_t* FindSentMsg
+(
+    uint8_t     msgRef,     ///< [IN] TP-MR of the status report
+    const char* recipient   ///< [IN] TP-RA of the status report
+)
+{
+    SentMsg_t* foundPtr = NULL;
+    uint32_t   msgRefMatchNb = 0;
+    int        i;
+
+    for (i = 0; i < SMS_DELIVERY_TRACKING_MAX; i++)
+    {
+        if ((!SentMsgTable[i].inUse) || (SentMsgTable[i].msgRef != msgRef))
+        {
+            continue;
+        }
+
+        if (strcmp(SentMsgTable[i].destination, recipient) == 0)
+        {
+            return &SentMsgTable[i];
+        }
+
+        foundPtr = &SentMsgTable[i];
+        msgRefMatchNb++;
+    }
+
+    return (msgRefMatchNb == 1) ? foundPtr : NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function decodes an SMS-STATUS-REPORT received with +CDS and reports the delivery of the
+ * matching sent message.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessStatusReport
+(
+    const char* pduStr  ///< [IN] Status report PDU in hexadecimal
+)
+{
+    uint8_t                  pdu[LE_SMS_PDU_MAX_BYTES];
+    char                     recipient[LE_MDMDEFS_PHONE_NUM_MAX_BYTES];
+    uint32_t                 offset;
+    uint32_t                 fieldLen;
+    uint8_t                  msgRef;
+    uint8_t                  status;
+    pa_sms_DeliveryOutcome_t outcome;
+    SentMsg_t*               sentMsgPtr;
+    le_clk_Time_t            now = le_clk_GetRelativeTime();
+    int32_t                  length = le_hex_StringToBinary(pduStr, strlen(pduStr),
+                                                            pdu, sizeof(pdu));
+
+    if (length < 1)
+    {
+        LE_WARN("Status report cannot be converted");
+        return;
+    }
+
+    // Skip SMSC address
+    offset = 1 + pdu[0];
+    if ((offset + 2 > (uint32_t)length) ||
+        ((pdu[offset] & SMS_TP_MTI_MASK) != SMS_TP_MTI_STATUS_REPORT))
+    {
+        LE_WARN("Not a status report");
+        return;
+    }
+
+    msgRef = pdu[offset + 1];
+    offset += 2;
+
+    if (DecodeAddress(pdu + offset, length - offset, recipient, sizeof(recipient),
+                      &fieldLen) != LE_OK)
+    {
+        LE_WARN("Cannot decode the recipient of status report %d", msgRef);
+        return;
+    }
+
+    // Skip TP-RA, TP-SCTS and TP-DT
+    offset += fieldLen + 2 * SMS_TP_TIMESTAMP_BYTES;
+    if (offset >= (uint32_t)length)
+    {
+        LE_WARN("Status report %d is truncated", msgRef);
+        return;
+    }
+    status = pdu[offset];
+
+    PurgeExpiredSentMsg(now);
+
+    sentMsgPtr = FindSentMsg(msgRef, recipient);
+    if (NULL == sentMsgPtr)
+    {
+        LE_DEBUG("No sent message matches status report %d to %s", msgRef, recipient);
+        return;
+    }
+
+    if (status < SMS_TP_ST_TEMPORARY_ERROR)
+    {
+        outcome = PA_SMS_DELIVERY_DELIVERED;
+    }
+    else if (status < SMS_TP_ST_PERMANENT_ERROR)
+    {
+        outcome = PA_SMS_DELIVERY_PENDING;
+    }
+    else
+    {
+        outcome = PA_SMS_DELIVERY_FAILED;
+    }
+
+    ReportDelivery(sentMsgPtr, status, outcome, now);
+
+    // The service centre is still trying: keep waiting for the final status report
+    if (PA_SMS_DELIVERY_PENDING != outcome)
+    {
+        sentMsgPtr->inUse = false;
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to register a handler for a new message reception handling.
@@ -168,11 +811,26 @@ static void UnsolicitedSmsHandler
     void* contextPtr
 )
 {
-    uint32_t msgIdx;
+    uint32_t         msgIdx;
+    pa_sms_Storage_t storage;
 
-    if (CheckSmsUnsolicited( (char*) unsolPtr,&msgIdx))
+    // +CDS is received on two lines: header then PDU
+    if (CdsPduExpected)
     {
-        ReportMsgIndex(msgIdx);
+        CdsPduExpected = false;
+        ProcessStatusReport(unsolPtr);
+        return;
+    }
+
+    if (FIND_STRING("+CDS:", unsolPtr))
+    {
+        CdsPduExpected = true;
+        return;
+    }
+
+    if (CheckSmsUnsolicited( (char*) unsolPtr,&msgIdx,&storage))
+    {
+        ReportMsgIndex(msgIdx,storage);
     }
 }
 
@@ -190,11 +848,18 @@ le_result_t pa_sms_Init
 )
 {
     NewSmsEventId = le_event_CreateId("NewSmsEventId",sizeof(pa_sms_NewMessageIndication_t));
+    DeliveryReportEventId = le_event_CreateId("DeliveryReportEventId",
+                                              sizeof(pa_sms_DeliveryReport_t));
 
     SmsPoolRef = le_mem_InitStaticPool(SmsPoolRef,DEFAULT_SMS_POOL_SIZE,sizeof(uint32_t));
 
     SmsHandlerRef = NULL;
 
+    if ((NULL_CHAR == CurrentMem[SMS_MEM_READ][0]) && (ReadPreferredMem() != LE_OK))
+    {
+        LE_WARN("Preferred message storages are not known");
+    }
+
     return LE_OK;
 }
 
@@ -252,6 +917,42 @@ le_result_t __attribute__((weak)) pa_sms_ClearNewMsgHandler
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register a handler for the delivery reports of sent messages.
+ *
+ * @return A handler reference, NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+le_event_HandlerRef_t pa_sms_AddDeliveryReportHandler
+(
+    pa_sms_DeliveryReportHdlrFunc_t handlerFuncPtr ///< [IN] The delivery report handler.
+)
+{
+    if (handlerFuncPtr == NULL)
+    {
+        LE_WARN("delivery report handler is NULL");
+        return NULL;
+    }
+
+    return le_event_AddHandler("DeliveryReportHandler",
+                               DeliveryReportEventId,
+                               (le_event_HandlerFunc_t) handlerFuncPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to unregister a delivery report handler.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sms_RemoveDeliveryReportHandler
+(
+    le_event_HandlerRef_t handlerRef ///< [IN] The handler reference.
+)
+{
+    le_event_RemoveHandler(handlerRef);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to initialize pattern matching for unsolicited message indicator.
@@ -769,6 +1470,7 @@ le_result_t pa_sms_SendPduMsg
             {
                 *msgRef = atoi(pa_utils_IsolateLineParameter(intermediateResponse, 2));
                  res = LE_OK;
+                 TrackSentMsg(*msgRef, dataPtr, length);
             }
             else
             {
@@ -819,6 +1521,12 @@ le_result_t pa_sms_RdPDUMsgFromMem
         return LE_BAD_PARAMETER;
     }
 
+    if (SelectReadStorage(storage) != LE_OK)
+    {
+        LE_ERROR("Failed to select storage %d", storage);
+        return LE_FAULT;
+    }
+
     snprintf(command,LE_ATDEFS_COMMAND_MAX_BYTES,"AT+CMGR=%"PRIu32,index);
 
     res = le_atClient_SetCommandAndSend(&cmdRef,
@@ -941,11 +1649,17 @@ le_result_t pa_sms_ListMsgFromMem
 
     *numPtr = 0;
 
-    if ((storage != PA_SMS_STORAGE_SIM) || (protocol != PA_SMS_PROTOCOL_GSM))
+    if ((NULL == StorageToMem(storage)) || (protocol != PA_SMS_PROTOCOL_GSM))
     {
         return res;
     }
 
+    if (SelectReadStorage(storage) != LE_OK)
+    {
+        LE_ERROR("Failed to select storage %d", storage);
+        return LE_FAULT;
+    }
+
     if (status == LE_SMS_RX_READ)
     {
         snprintf(command,LE_ATDEFS_COMMAND_MAX_BYTES,"AT+CMGL=1");
@@ -1040,6 +1754,12 @@ le_result_t pa_sms_DelMsgFromMem
     le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_FAULT;
 
+    if (SelectReadStorage(storage) != LE_OK)
+    {
+        LE_ERROR("Failed to select storage %d", storage);
+        return LE_FAULT;
+    }
+
     snprintf(command,LE_ATDEFS_COMMAND_MAX_BYTES,"AT+CMGD=%"PRIu32",0",index);
 
     res = le_atClient_SetCommandAndSend(&cmdRef,
@@ -1123,6 +1843,91 @@ le_result_t pa_sms_DelAllMsg
     return res;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the preferred message storages.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER Bad parameter, one is NULL.
+ * @return LE_TIMEOUT       No response was received from the Modem.
+ * @return LE_FAULT         The function failed to get the preferred message storages.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_GetPreferredStorage
+(
+    pa_sms_Storage_t* readPtr,      ///< [OUT] Storage used to read, list and delete messages.
+    pa_sms_Storage_t* writePtr,     ///< [OUT] Storage used to write and send messages.
+    pa_sms_Storage_t* receivePtr    ///< [OUT] Storage used for received messages.
+)
+{
+    if (!readPtr || !writePtr || !receivePtr)
+    {
+        LE_WARN("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    if ((NULL_CHAR == CurrentMem[SMS_MEM_READ][0]) ||
+        (NULL_CHAR == CurrentMem[SMS_MEM_WRITE][0]) ||
+        (NULL_CHAR == CurrentMem[SMS_MEM_RECEIVE][0]))
+    {
+        le_result_t res = ReadPreferredMem();
+        if (res != LE_OK)
+        {
+            return res;
+        }
+    }
+
+    *readPtr    = MemToStorage(CurrentMem[SMS_MEM_READ]);
+    *writePtr   = MemToStorage(CurrentMem[SMS_MEM_WRITE]);
+    *receivePtr = MemToStorage(CurrentMem[SMS_MEM_RECEIVE]);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the preferred message storages. AT+CPMS is only sent when one of them
+ * differs from the current configuration.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER A storage is not supported.
+ * @return LE_TIMEOUT       No response was received from the Modem.
+ * @return LE_FAULT         The function failed to set the preferred message storages.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_SetPreferredStorage
+(
+    pa_sms_Storage_t read,      ///< [IN] Storage used to read, list and delete messages.
+    pa_sms_Storage_t write,     ///< [IN] Storage used to write and send messages.
+    pa_sms_Storage_t receive    ///< [IN] Storage used for received messages.
+)
+{
+    const char* memPtr[SMS_MEM_NB];
+    int         i;
+
+    memPtr[SMS_MEM_READ]    = StorageToMem(read);
+    memPtr[SMS_MEM_WRITE]   = StorageToMem(write);
+    memPtr[SMS_MEM_RECEIVE] = StorageToMem(receive);
+
+    for (i = 0; i < SMS_MEM_NB; i++)
+    {
+        if (NULL == memPtr[i])
+        {
+            LE_WARN("Storage %d is not supported", i);
+            return LE_BAD_PARAMETER;
+        }
+    }
+
+    if ((strcmp(CurrentMem[SMS_MEM_READ], memPtr[SMS_MEM_READ]) == 0) &&
+        (strcmp(CurrentMem[SMS_MEM_WRITE], memPtr[SMS_MEM_WRITE]) == 0) &&
+        (strcmp(CurrentMem[SMS_MEM_RECEIVE], memPtr[SMS_MEM_RECEIVE]) == 0))
+    {
+        return LE_OK;
+    }
+
+    return WritePreferredMem(memPtr, SMS_MEM_NB);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function saves the SMS Settings.
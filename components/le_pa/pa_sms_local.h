@@ -102,6 +102,50 @@ typedef enum
 pa_sms_NmiBfr_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Outcome of a sent message, decoded from the TP-Status of its SMS-STATUS-REPORT.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PA_SMS_DELIVERY_DELIVERED = 0, ///< Short message transaction completed (TP-ST 0x00-0x1F).
+    PA_SMS_DELIVERY_PENDING   = 1, ///< Temporary error, SC still trying (TP-ST 0x20-0x3F).
+    PA_SMS_DELIVERY_FAILED    = 2, ///< Permanent error or SC stopped trying (TP-ST 0x40-0x7F).
+    PA_SMS_DELIVERY_EXPIRED   = 3, ///< No status report received before the tracking timeout.
+}
+pa_sms_DeliveryOutcome_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delivery report of a sent message, correlated with its submission by TP-MR and destination.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t                  msgRef;       ///< TP-MR of the message.
+    char                     destination[LE_MDMDEFS_PHONE_NUM_MAX_BYTES];
+                                           ///< Destination address of the message.
+    uint8_t                  status;       ///< TP-Status of the status report.
+    pa_sms_DeliveryOutcome_t outcome;      ///< Delivery outcome.
+    uint32_t                 latencyMs;    ///< Time elapsed since the submission, in ms.
+}
+pa_sms_DeliveryReport_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype for handler functions used to report the delivery of sent messages.
+ *
+ * @param reportPtr The delivery report.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*pa_sms_DeliveryReportHdlrFunc_t)
+(
+    pa_sms_DeliveryReport_t* reportPtr
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to initialize the sms module.
@@ -170,6 +214,40 @@ le_result_t pa_sms_SetMsgFormat
     le_sms_Format_t   format   ///< [IN] The preferred message format.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the preferred message storages.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER Bad parameter, one is NULL.
+ * @return LE_TIMEOUT       No response was received from the Modem.
+ * @return LE_FAULT         The function failed to get the preferred message storages.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_GetPreferredStorage
+(
+    pa_sms_Storage_t* readPtr,      ///< [OUT] Storage used to read, list and delete messages.
+    pa_sms_Storage_t* writePtr,     ///< [OUT] Storage used to write and send messages.
+    pa_sms_Storage_t* receivePtr    ///< [OUT] Storage used for received messages.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the preferred message storages (AT+CPMS).
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER A storage is not supported.
+ * @return LE_TIMEOUT       No response was received from the Modem.
+ * @return LE_FAULT         The function failed to set the preferred message storages.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sms_SetPreferredStorage
+(
+    pa_sms_Storage_t read,      ///< [IN] Storage used to read, list and delete messages.
+    pa_sms_Storage_t write,     ///< [IN] Storage used to write and send messages.
+    pa_sms_Storage_t receive    ///< [IN] Storage used for received messages.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function saves the SMS Settings.
@@ -184,4 +262,28 @@ le_result_t pa_sms_SaveSettings
     void
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register a handler for the delivery reports of sent messages.
+ *
+ * @note Status reports are only correlated when they are routed with +CDS (PA_SMS_DS_1).
+ *
+ * @return A handler reference, NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+le_event_HandlerRef_t pa_sms_AddDeliveryReportHandler
+(
+    pa_sms_DeliveryReportHdlrFunc_t handlerFuncPtr ///< [IN] The delivery report handler.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to unregister a delivery report handler.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sms_RemoveDeliveryReportHandler
+(
+    le_event_HandlerRef_t handlerRef ///< [IN] The handler reference.
+);
+
 #endif // LEGATO_PASMSLOCAL_INCLUDE_GUARD
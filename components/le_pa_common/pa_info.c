@@ -16,128 +16,163 @@
 #endif
 
 #include "pa_utils.h"
+#include "pa_info_local.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function get the International Mobile Equipment Identity (IMEI).
+ * Command line collecting the device identity, its responses come in the IdentityFields order
+ */
+//--------------------------------------------------------------------------------------------------
+#define IDENTITY_COMMAND        "AT+CGMI;+CGMM;+CGMR;+CGSN;+WSVN?"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Device identity fields
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    IDENTITY_MANUFACTURER_NAME = 0,
+    IDENTITY_DEVICE_MODEL,
+    IDENTITY_FIRMWARE_VERSION,
+    IDENTITY_IMEI,
+    IDENTITY_IMEISV,
+    IDENTITY_MAX
+}
+IdentityFieldId_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Device identity snapshot. It does not change while the modem runs, so it is collected once and
+ * only invalidated by a firmware update.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool                  isValid;                                      ///< Snapshot collected
+    char                  manufacturerName[LE_INFO_MAX_MFR_NAME_BYTES]; ///< AT+CGMI
+    pa_info_DeviceModel_t model;                                        ///< AT+CGMM
+    char                  firmwareVersion[LE_INFO_MAX_VERS_BYTES];      ///< AT+CGMR
+    pa_info_Imei_t        imei;                                         ///< AT+CGSN
+    pa_info_ImeiSv_t      imeiSv;                                       ///< AT+WSVN?
+}
+DeviceIdentity_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Device identity field description
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* commandPtr;     ///< Command reading the field alone
+    const char* prefixPtr;      ///< Response prefix, NULL if the response has none
+    size_t      offset;         ///< Field offset in DeviceIdentity_t
+    size_t      size;           ///< Field size
+}
+IdentityField_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Device identity fields descriptions, indexed by IdentityFieldId_t
+ */
+//--------------------------------------------------------------------------------------------------
+#define IDENTITY_FIELD(cmd, prefix, field) \
+    { cmd, prefix, offsetof(DeviceIdentity_t, field), sizeof(((DeviceIdentity_t*)0)->field) }
+
+static const IdentityField_t IdentityFields[IDENTITY_MAX] =
+{
+    [IDENTITY_MANUFACTURER_NAME] = IDENTITY_FIELD("AT+CGMI",  NULL,     manufacturerName),
+    [IDENTITY_DEVICE_MODEL]      = IDENTITY_FIELD("AT+CGMM",  NULL,     model),
+    [IDENTITY_FIRMWARE_VERSION]  = IDENTITY_FIELD("AT+CGMR",  NULL,     firmwareVersion),
+    [IDENTITY_IMEI]              = IDENTITY_FIELD("AT+CGSN",  NULL,     imei),
+    [IDENTITY_IMEISV]            = IDENTITY_FIELD("AT+WSVN?", "+WSVN:", imeiSv),
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Device identity snapshot
+ */
+//--------------------------------------------------------------------------------------------------
+static DeviceIdentity_t DeviceIdentity;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store a device identity field from its response line.
  *
- * @return  LE_OK            The function succeeded.
- * @return  LE_BAD_PARAMETER The parameters are invalid.
- * @return  LE_TIMEOUT       No response was received from the Modem.
- * @return  LE_FAULT         The function failed to get the value.
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT if the line is not the field response
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_info_GetImei
+static le_result_t StoreIdentityField
 (
-    pa_info_Imei_t imei   ///< [OUT] IMEI value
+    IdentityFieldId_t fieldId,      ///< [IN] Field
+    const char*       linePtr       ///< [IN] Response line
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-    char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    const IdentityField_t* fieldPtr = &IdentityFields[fieldId];
+    char*                  valuePtr = (char*)&DeviceIdentity + fieldPtr->offset;
 
-    if (!imei)
+    if (fieldPtr->prefixPtr)
     {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
-    }
+        if (0 != strncmp(linePtr, fieldPtr->prefixPtr, strlen(fieldPtr->prefixPtr)))
+        {
+            return LE_FAULT;
+        }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CGSN",
-                                        "0|1|2|3|4|5|6|7|8|9",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
+        linePtr += strlen(fieldPtr->prefixPtr);
+        while (' ' == *linePtr)
+        {
+            linePtr++;
+        }
     }
 
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       finalResponse,
-                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
-
-    if (res != LE_OK)
+    if (LE_OK != le_utf8_Copy(valuePtr, linePtr, fieldPtr->size, NULL))
     {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
-    }
-    else if (strcmp(finalResponse,"OK") != 0)
-    {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
+        LE_WARN("Identity field %d truncated", fieldId);
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   intermediateResponse,
-                                                   LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-    }
-    else
-    {
-        strncpy(imei, intermediateResponse, strlen(intermediateResponse));
-    }
-    le_atClient_Delete(cmdRef);
-    return res;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function get the International Mobile Equipment Identity software version number (IMEISV).
+ * Collect the device identity with a single command line.
  *
- * @return  LE_OK            The function succeeded.
- * @return  LE_BAD_PARAMETER The parameters are invalid.
- * @return  LE_TIMEOUT       No response was received from the Modem.
- * @return  LE_FAULT         The function failed to get the value.
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT if a command failed or the responses cannot be matched to the fields
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_info_GetImeiSv
+static le_result_t CollectIdentityAtOnce
 (
-    pa_info_ImeiSv_t imeiSv   ///< [OUT] IMEISV value
+    void
 )
 {
     le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
+    le_result_t          res;
     char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
     char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-
-    if (!imeiSv)
-    {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
-    }
+    uint32_t             fieldId = 0;
 
     res = le_atClient_SetCommandAndSend(&cmdRef,
                                         pa_utils_GetAtDeviceRef(),
-                                        "AT+WSVN?",
+                                        IDENTITY_COMMAND,
                                         "",
                                         DEFAULT_AT_RESPONSE,
                                         DEFAULT_AT_CMD_TIMEOUT);
     if (res != LE_OK)
     {
         LE_ERROR("Failed to send the command");
-        return res;
+        return LE_FAULT;
     }
 
     res = le_atClient_GetFinalResponse(cmdRef,
                                        finalResponse,
                                        LE_ATDEFS_RESPONSE_MAX_BYTES);
-
-    if (res != LE_OK)
+    if ((res != LE_OK) || (strcmp(finalResponse, "OK") != 0))
     {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
-    }
-    else if (strcmp(finalResponse,"OK") != 0)
-    {
-        LE_ERROR("Final response is not OK");
         le_atClient_Delete(cmdRef);
         return LE_FAULT;
     }
@@ -145,89 +180,205 @@ le_result_t pa_info_GetImeiSv
     res = le_atClient_GetFirstIntermediateResponse(cmdRef,
                                                    intermediateResponse,
                                                    LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
+    while ((LE_OK == res) && (fieldId < IDENTITY_MAX))
     {
-        LE_ERROR("Failed to get the response");
+        if (LE_OK != StoreIdentityField(fieldId, intermediateResponse))
+        {
+            break;
+        }
+        fieldId++;
+
+        res = le_atClient_GetNextIntermediateResponse(cmdRef,
+                                                      intermediateResponse,
+                                                      LE_ATDEFS_RESPONSE_MAX_BYTES);
     }
-    else
+
+    le_atClient_Delete(cmdRef);
+
+    // Each command must have answered exactly one line
+    if ((IDENTITY_MAX != fieldId) || (LE_OK == res))
     {
-        strncpy(imeiSv, intermediateResponse, strlen(intermediateResponse));
+        LE_WARN("Unexpected identity responses");
+        return LE_FAULT;
     }
-    le_atClient_Delete(cmdRef);
-    return res;
+
+    return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Collect the device identity snapshot.
+ *
+ * The identity is read with a single command line. When the modem rejects it, e.g. because one
+ * of the commands is not supported, each field is read on its own.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CollectIdentity
+(
+    void
+)
+{
+    char     responseStr[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    uint32_t fieldId;
+
+    memset(&DeviceIdentity, 0, sizeof(DeviceIdentity));
+
+    if (LE_OK == CollectIdentityAtOnce())
+    {
+        DeviceIdentity.isValid = true;
+        return;
+    }
+
+    memset(&DeviceIdentity, 0, sizeof(DeviceIdentity));
+
+    for (fieldId = 0; fieldId < IDENTITY_MAX; fieldId++)
+    {
+        const IdentityField_t* fieldPtr = &IdentityFields[fieldId];
+
+        if ((LE_OK == pa_utils_GetATIntermediateResponse(fieldPtr->commandPtr,
+                                                         fieldPtr->prefixPtr ?
+                                                         fieldPtr->prefixPtr : "",
+                                                         responseStr,
+                                                         sizeof(responseStr)))
+            && (LE_OK == StoreIdentityField(fieldId, responseStr)))
+        {
+            // One field is enough to know that the modem answers
+            DeviceIdentity.isValid = true;
+        }
+        else
+        {
+            LE_WARN("Identity field %d not available", fieldId);
+        }
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the firmware version string.
+ * Get a device identity field from the snapshot, collected on first use.
  *
  * @return
  *      - LE_OK on success
  *      - LE_BAD_PARAMETER The parameters are invalid.
- *      - LE_NOT_FOUND if the version string is not available
- *      - LE_FAULT for any other errors
+ *      - LE_OVERFLOW      The field does not fit in the buffer.
+ *      - LE_FAULT         The field is not available.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_info_GetFirmwareVersion
+static le_result_t GetIdentityField
 (
-    char*  versionPtr,       ///< [OUT] Firmware version string.
-    size_t versionSize       ///< [IN] Size of version buffer.
+    IdentityFieldId_t fieldId,      ///< [IN] Field
+    char*             strPtr,       ///< [OUT] Field value
+    size_t            strSize       ///< [IN] Field value buffer size
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-    char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    const char* valuePtr = (const char*)&DeviceIdentity + IdentityFields[fieldId].offset;
 
-    if (!versionPtr)
+    if (!strPtr)
     {
         LE_DEBUG("One parameter is NULL");
         return LE_BAD_PARAMETER;
     }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CGMR",
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-    if (res != LE_OK)
+    if (!DeviceIdentity.isValid)
     {
-        LE_ERROR("Failed to send the command");
-        return res;
+        CollectIdentity();
     }
 
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       finalResponse,
-                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
-    }
-    else if (strcmp(finalResponse,"OK") != 0)
+    if (NULL_CHAR == valuePtr[0])
     {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
+        LE_ERROR("Identity field %d not available", fieldId);
         return LE_FAULT;
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   intermediateResponse,
-                                                   LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-    }
-    else
-    {
-        strncpy(versionPtr, intermediateResponse, versionSize);
-    }
-    le_atClient_Delete(cmdRef);
-    return res;
+    return le_utf8_Copy(strPtr, valuePtr, strSize, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to initialize the info module. It collects the device identity
+ * snapshot.
+ *
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_info_Init
+(
+    void
+)
+{
+    CollectIdentity();
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the device identity snapshot, e.g. after a firmware update. It is collected again on
+ * its next access.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_info_local_InvalidateIdentity
+(
+    void
+)
+{
+    LE_DEBUG("Invalidate the device identity");
+    DeviceIdentity.isValid = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function get the International Mobile Equipment Identity (IMEI).
+ *
+ * @return  LE_OK            The function succeeded.
+ * @return  LE_BAD_PARAMETER The parameters are invalid.
+ * @return  LE_TIMEOUT       No response was received from the Modem.
+ * @return  LE_FAULT         The function failed to get the value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_info_GetImei
+(
+    pa_info_Imei_t imei   ///< [OUT] IMEI value
+)
+{
+    return GetIdentityField(IDENTITY_IMEI, imei, sizeof(pa_info_Imei_t));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function get the International Mobile Equipment Identity software version number (IMEISV).
+ *
+ * @return  LE_OK            The function succeeded.
+ * @return  LE_BAD_PARAMETER The parameters are invalid.
+ * @return  LE_TIMEOUT       No response was received from the Modem.
+ * @return  LE_FAULT         The function failed to get the value.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_info_GetImeiSv
+(
+    pa_info_ImeiSv_t imeiSv   ///< [OUT] IMEISV value
+)
+{
+    return GetIdentityField(IDENTITY_IMEISV, imeiSv, sizeof(pa_info_ImeiSv_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the firmware version string.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER The parameters are invalid.
+ *      - LE_NOT_FOUND if the version string is not available
+ *      - LE_FAULT for any other errors
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_info_GetFirmwareVersion
+(
+    char*  versionPtr,       ///< [OUT] Firmware version string.
+    size_t versionSize       ///< [IN] Size of version buffer.
+)
+{
+    return GetIdentityField(IDENTITY_FIRMWARE_VERSION, versionPtr, versionSize);
 }
 
 
@@ -372,58 +523,7 @@ le_result_t pa_info_GetDeviceModel
     pa_info_DeviceModel_t model   ///< [OUT] Model string (null-terminated).
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-    char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-
-    if (!model)
-    {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
-    }
-
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CGMM",
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       finalResponse,
-                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
-    }
-    else if (strcmp(finalResponse,"OK") != 0)
-    {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
-    }
-
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   intermediateResponse,
-                                                   LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-    }
-    else
-    {
-        strncpy(model, intermediateResponse, strlen(intermediateResponse));
-    }
-    le_atClient_Delete(cmdRef);
-    return res;
+    return GetIdentityField(IDENTITY_DEVICE_MODEL, model, sizeof(pa_info_DeviceModel_t));
 }
 
 
@@ -574,59 +674,7 @@ le_result_t pa_info_GetManufacturerName
     size_t mfrNameStrNumElements    ///< [IN] Size of Manufacturer Name string.
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-    char                 intermediateResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-    char                 finalResponse[LE_ATDEFS_RESPONSE_MAX_BYTES];
-
-    if (!mfrNameStr)
-    {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
-    }
-
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+CGMI",
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       finalResponse,
-                                       LE_ATDEFS_RESPONSE_MAX_BYTES);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        return res;
-    }
-    else if (strcmp(finalResponse,"OK") != 0)
-    {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
-    }
-
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   intermediateResponse,
-                                                   LE_ATDEFS_RESPONSE_MAX_BYTES);
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the response");
-    }
-    else
-    {
-        strncpy(mfrNameStr, intermediateResponse, mfrNameStrNumElements);
-    }
-    le_atClient_Delete(cmdRef);
-    return res;
+    return GetIdentityField(IDENTITY_MANUFACTURER_NAME, mfrNameStr, mfrNameStrNumElements);
 }
 
 //--------------------------------------------------------------------------------------------------
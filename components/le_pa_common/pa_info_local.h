@@ -0,0 +1,36 @@
+/** @file pa_info_local.h
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_PAINFOLOCAL_INCLUDE_GUARD
+#define LEGATO_PAINFOLOCAL_INCLUDE_GUARD
+
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to initialize the info module. It collects the device identity
+ * snapshot.
+ *
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t pa_info_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the device identity snapshot, e.g. after a firmware update. It is collected again on
+ * its next access.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void pa_info_local_InvalidateIdentity
+(
+    void
+);
+
+#endif // LEGATO_PAINFOLOCAL_INCLUDE_GUARD
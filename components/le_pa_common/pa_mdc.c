@@ -71,12 +71,8 @@ le_result_t pa_mdc_GetGatewayAddress
     size_t                  gatewayAddrStrSize ///< [IN]  The size in bytes of the address buffer
 )
 {
-    le_atClient_CmdRef_t cmdRef   = NULL;
-    le_result_t          res      = LE_FAULT;
-    static const char    cgcontrdpStr[]="AT+CGCONTRDP=";
-    char                 commandStr[sizeof(cgcontrdpStr)+PA_AT_COMMAND_PADDING] ;
-    char                 responseStr[PA_AT_LOCAL_LONG_STRING_SIZE];
-    char                 gwStr[DEFAULT_AT_BUFFER_SHORT_BYTES];
+    pa_mdc_utils_IpParam_t ipParam;
+    le_result_t            res;
 
     if (!profileIndex)
     {
@@ -85,116 +81,29 @@ le_result_t pa_mdc_GetGatewayAddress
     }
     gatewayAddrStr[0] = NULL_CHAR;
 
-    // AT+CGCONTRDP command used to retrieve the IPv4 GW
-    // profileIndex is the CID
-    snprintf(commandStr, sizeof(commandStr),"%s%"PRIu32, cgcontrdpStr, profileIndex);
-    snprintf(responseStr, sizeof(responseStr),"+CGCONTRDP: %"PRIu32, profileIndex);
-
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        commandStr,
-                                        responseStr,
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    responseStr[0] = NULL_CHAR;
-    res = le_atClient_GetFinalResponse(cmdRef,
-                                       responseStr,
-                                       sizeof(responseStr));
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to get the final response");
-        le_atClient_Delete(cmdRef);
-        return res;
-    }
-    else if (strcmp(responseStr,"OK") != 0)
-    {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
-    }
-
-
-    responseStr[0] = NULL_CHAR;
-    // Get First response
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-                                                   responseStr,
-                                                   sizeof(responseStr));
+    // The gateway comes from the AT+CGCONTRDP snapshot of the context
+    res = pa_mdc_utils_GetIpParam(profileIndex, ipVersion, &ipParam);
     if (res != LE_OK)
     {
-        LE_ERROR("Failed to get the intermediate response");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
-    }
-
-    // Extract the IP address from the response
-    res = pa_mdc_util_GetGWAddr(responseStr, gwStr, sizeof(gwStr));
-    if(LE_OK != res)
-    {
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
-    }
-
-    // Check address type
-    if(pa_mdc_util_CheckConvertIPAddressFormat(gwStr, ipVersion))
-    {
-        le_atClient_Delete(cmdRef);
-        res = le_utf8_Copy(gatewayAddrStr, gwStr, gatewayAddrStrSize, NULL);
         return res;
     }
 
-    responseStr[0] = NULL_CHAR;
-    // Get Second response if the first one doen't match
-    res = le_atClient_GetNextIntermediateResponse(cmdRef,
-                                                  responseStr,
-                                                  sizeof(responseStr));
-    le_atClient_Delete(cmdRef);
-
-    if (res != LE_OK)
+    if (NULL_CHAR == ipParam.gw[0])
     {
-        if(LE_MDMDEFS_IPV6 == ipVersion)
+        if (LE_MDMDEFS_IPV6 == ipVersion)
         {
             res = GetIpv6DefaultGateway(profileIndex, gatewayAddrStr, gatewayAddrStrSize);
             LE_WARN("No Gw found %s", gatewayAddrStr);
             return res;
         }
-        LE_WARN("Failed to get the second intermediate response");
-        return res;
-    }
-
-    // Extract the IP address from the response
-    res = pa_mdc_util_GetGWAddr(responseStr, gwStr, sizeof(gwStr));
-    if(LE_OK != res)
-    {
-        return res;
-    }
-
-    // Check address type
-    if(pa_mdc_util_CheckConvertIPAddressFormat(gwStr, ipVersion))
-    {
-        res = le_utf8_Copy(gatewayAddrStr, gwStr, gatewayAddrStrSize, NULL);
-    }
-    else
-    {
-        if(LE_MDMDEFS_IPV6 == ipVersion)
-        {
-            res = GetIpv6DefaultGateway(profileIndex, gatewayAddrStr, gatewayAddrStrSize);
-            return res;
-        }
-        res = LE_FAULT;
+        return LE_FAULT;
     }
 
-    return res;
+    return le_utf8_Copy(gatewayAddrStr, ipParam.gw, gatewayAddrStrSize, NULL);
 }
 
 
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Reject a MT-PDP data session for the given profile
@@ -314,11 +223,41 @@ le_result_t pa_mdc_GetProfileList
     size_t* listSize                   ///< [INOUT] list size
 )
 {
-    LE_UNUSED(profileList);
-    LE_UNUSED(listSize);
+    pa_mdc_ProfileData_t profileData;
+    uint32_t             profileIndex;
+    size_t               nbProfiles = 0;
+    le_result_t          res;
 
-    LE_ERROR("Unsupported function called");
-    return LE_UNSUPPORTED;
+    if ((!profileList) || (!listSize))
+    {
+        LE_ERROR("One parameter is NULL");
+        return LE_FAULT;
+    }
+
+    // All the contexts come from the profile cache, read at most once from the modem
+    for (profileIndex = 1; (profileIndex <= PA_MDC_MAX_PROFILE) && (nbProfiles < *listSize);
+         profileIndex++)
+    {
+        res = pa_mdc_utils_GetCachedProfile(profileIndex, &profileData);
+        if (LE_NOT_FOUND == res)
+        {
+            continue;
+        }
+        else if (LE_OK != res)
+        {
+            return LE_FAULT;
+        }
+
+        memset(&profileList[nbProfiles], 0, sizeof(le_mdc_ProfileInfo_t));
+        profileList[nbProfiles].index = profileIndex;
+        le_utf8_Copy(profileList[nbProfiles].name, profileData.apn,
+                     sizeof(profileList[nbProfiles].name), NULL);
+        nbProfiles++;
+    }
+
+    *listSize = nbProfiles;
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -59,6 +59,35 @@
 #define NB_DOT_IPV6_ADDR    15
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reconnection policy of the data sessions dropped by the network. The delay between two attempts
+ * doubles from initialDelayMs up to maxDelayMs, with a random jitter of up to half of the delay.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool     isEnabled;         ///< Reconnect the data sessions dropped by the network
+    uint32_t initialDelayMs;    ///< Delay before the first attempt, in ms
+    uint32_t maxDelayMs;        ///< Maximum delay between two attempts, in ms
+    uint32_t maxAttempts;       ///< Number of attempts before giving up, 0 for no limit
+}
+pa_mdc_ReconnectPolicy_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reconnection counters of a data session
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t attemptCount;      ///< Reconnection attempts
+    uint32_t successCount;      ///< Successful reconnections
+    uint32_t failureCount;      ///< Failed reconnection attempts
+    uint32_t abandonCount;      ///< Reconnections given up after maxAttempts
+}
+pa_mdc_ReconnectCounters_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to initialize the mdc module
@@ -72,6 +101,46 @@ le_result_t pa_mdc_Init
     void
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the reconnection policy of the data sessions dropped by the network
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The policy is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_SetReconnectPolicy
+(
+    const pa_mdc_ReconnectPolicy_t* policyPtr   ///< [IN] The reconnection policy
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the APN used to create a profile which does not exist on the modem
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_OVERFLOW      The APN is too long.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_SetDefaultApn
+(
+    const char* apnPtr          ///< [IN] The default APN, empty for none
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the reconnection counters of a data session
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_GetReconnectCounters
+(
+    uint32_t                    profileIndex,   ///< [IN]  The profile to use
+    pa_mdc_ReconnectCounters_t* countersPtr     ///< [OUT] The reconnection counters
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get profileIndex from PDP cid
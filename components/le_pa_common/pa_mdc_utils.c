@@ -18,6 +18,53 @@
 #include "pa_mdc_utils_local.h"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * PDP context of a profile, as read from AT+CGDCONT? and AT+CGAUTH?
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool                 isDefined;     ///< The context is defined on the modem
+    pa_mdc_ProfileData_t profileData;   ///< The context parameters
+}
+ProfileCacheEntry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Profile cache, indexed by profile index. It is filled from one read of the full AT+CGDCONT? and
+ * AT+CGAUTH? listings and invalidated when a profile is written.
+ */
+//--------------------------------------------------------------------------------------------------
+static ProfileCacheEntry_t ProfileCache[PA_MDC_MAX_PROFILE + 1];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Profile cache validity
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsProfileCacheValid = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dynamic parameters of a data session, read from AT+CGPADDR and AT+CGCONTRDP
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool                   isValid;     ///< The snapshot is filled
+    pa_mdc_utils_IpParam_t ipv4;        ///< IPv4 parameters
+    pa_mdc_utils_IpParam_t ipv6;        ///< IPv6 parameters
+}
+SessionParam_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dynamic parameters snapshots, indexed by profile index
+ */
+//--------------------------------------------------------------------------------------------------
+static SessionParam_t SessionParams[PA_MDC_MAX_PROFILE + 1];
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Count myChar occurence in the inputString string
@@ -128,111 +175,310 @@ le_result_t pa_mdc_utils_AttachPS
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to retrieve the PDP type from PDP Context
+ * Parse a +CGDCONT: line into the profile cache
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseCgdcontLine
+(
+    char* lineStr               ///< [IN] +CGDCONT: line
+)
+{
+    //  +CGDCONT: <cid>,<PDP_type>,<APN>,<PDP_addr>,<d_comp>,<h_comp>...
+    //  +CGDCONT: 1,"IP","orange.fr",,0,0,0,0,0,,0
+    //  +CGDCONT: 2,"IPV4V6","VZWADMIN",,0,0,0,0,0,,0
+    //  +CGDCONT: 3,"IPV4V6",,,0,0,0,0,0,,0
+    uint32_t             numParam = pa_utils_CountAndIsolateLineParameters(lineStr);
+    uint32_t             profileIndex;
+    pa_mdc_ProfileData_t* profileDataPtr;
+    char*                pdpTypeStr;
+
+    if (numParam < 3)
+    {
+        LE_WARN("Unexpected +CGDCONT line");
+        return;
+    }
+
+    profileIndex = pa_mdc_local_GetProfileIndexFromCid(
+                                        atoi(pa_utils_IsolateLineParameter(lineStr, 2)));
+    if ((!profileIndex) || (profileIndex > PA_MDC_MAX_PROFILE))
+    {
+        return;
+    }
+
+    profileDataPtr = &ProfileCache[profileIndex].profileData;
+    ProfileCache[profileIndex].isDefined = true;
+
+    pdpTypeStr = pa_utils_IsolateLineParameter(lineStr, 3);
+    pa_utils_RemoveQuotationString(pdpTypeStr);
+    if (0 == strcmp(pdpTypeStr, "IPV4V6"))
+    {
+        profileDataPtr->pdp = LE_MDC_PDP_IPV4V6;
+    }
+    else if (0 == strcmp(pdpTypeStr, "IPV6"))
+    {
+        profileDataPtr->pdp = LE_MDC_PDP_IPV6;
+    }
+    else
+    {
+        profileDataPtr->pdp = LE_MDC_PDP_IPV4;
+    }
+
+    if (numParam >= 4)
+    {
+        char* apnStr = pa_utils_IsolateLineParameter(lineStr, 4);
+
+        pa_utils_RemoveQuotationString(apnStr);
+        le_utf8_Copy(profileDataPtr->apn, apnStr, sizeof(profileDataPtr->apn), NULL);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a +CGAUTH: line into the profile cache
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseCgauthLine
+(
+    char* lineStr               ///< [IN] +CGAUTH: line
+)
+{
+    //  +CGAUTH: <cid>,<auth_prot>,<userid>,<password>
+    //  +CGAUTH: 1,1,,
+    //  +CGAUTH: 7,2,"login","passwd"
+    uint32_t                 numParam = pa_utils_CountAndIsolateLineParameters(lineStr);
+    uint32_t                 profileIndex;
+    pa_mdc_Authentication_t* authPtr;
+    char*                    paramStr;
+
+    if (numParam < 3)
+    {
+        LE_WARN("Unexpected +CGAUTH line");
+        return;
+    }
+
+    profileIndex = pa_mdc_local_GetProfileIndexFromCid(
+                                        atoi(pa_utils_IsolateLineParameter(lineStr, 2)));
+    if ((!profileIndex) || (profileIndex > PA_MDC_MAX_PROFILE))
+    {
+        return;
+    }
+
+    authPtr = &ProfileCache[profileIndex].profileData.authentication;
+
+    switch (atoi(pa_utils_IsolateLineParameter(lineStr, 3)))
+    {
+        case 1:
+            authPtr->type = LE_MDC_AUTH_PAP;
+            break;
+        case 2:
+            authPtr->type = LE_MDC_AUTH_CHAP;
+            break;
+        case 3:
+            authPtr->type = LE_MDC_AUTH_PAP | LE_MDC_AUTH_CHAP;
+            break;
+        default:
+            authPtr->type = LE_MDC_AUTH_NONE;
+            break;
+    }
+
+    if (numParam >= 4)
+    {
+        paramStr = pa_utils_IsolateLineParameter(lineStr, 4);
+        pa_utils_RemoveQuotationString(paramStr);
+        le_utf8_Copy(authPtr->userName, paramStr, sizeof(authPtr->userName), NULL);
+    }
+
+    if (numParam >= 5)
+    {
+        paramStr = pa_utils_IsolateLineParameter(lineStr, 5);
+        pa_utils_RemoveQuotationString(paramStr);
+        le_utf8_Copy(authPtr->password, paramStr, sizeof(authPtr->password), NULL);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a read command and parse all its intermediate responses with the given parser
  *
  * @return LE_OK            The function succeeded.
- * @return LE_BAD_PARAMETER The parameters are invalid.
  * @return LE_TIMEOUT       No response was received.
  * @return LE_FAULT         The function failed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_mdc_utils_GetPDPType
+static le_result_t ReadListing
 (
-    uint32_t profileIndex,               ///< [IN]  The profile to use
-    le_mdc_Pdp_t *pdpTypePtr             ///< [OUT] The PDP Type
+    const char* commandStr,                 ///< [IN] Read command
+    const char* intermediateStr,            ///< [IN] Intermediate response prefix
+    void        (*parserFunc)(char*)        ///< [IN] Intermediate response parser
 )
 {
-    le_atClient_CmdRef_t cmdRef   = NULL;
-    le_result_t          res      = LE_FAULT;
-    static const  char   cgdcontStr[]="+CGDCONT: ";
-    char*                tokenPtr = NULL;
-    char*                savePtr  = NULL;
-    char                 responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res;
+    char                 responseStr[PA_AT_LOCAL_LONG_STRING_SIZE] = {0};
 
-    if ((!profileIndex) || (!pdpTypePtr))
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        commandStr,
+                                        intermediateStr,
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
     {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
+        LE_ERROR("Failed to send %s", commandStr);
+        return res;
     }
 
-    snprintf(responseStr, PA_AT_LOCAL_SHORT_SIZE, "%s%d,",cgdcontStr, (int) profileIndex);
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    if ((res != LE_OK) || (strcmp(responseStr, "OK") != 0))
+    {
+        LE_ERROR("Final response of %s is not OK", commandStr);
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-        pa_utils_GetAtDeviceRef(),
-        "AT+CGDCONT?",
-        responseStr,
-        DEFAULT_AT_RESPONSE,
-        DEFAULT_AT_CMD_TIMEOUT);
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    while (LE_OK == res)
+    {
+        parserFunc(responseStr);
+        res = le_atClient_GetNextIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    }
+
+    le_atClient_Delete(cmdRef);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill the profile cache if it is not valid
+ *
+ * @return LE_OK            The profile cache is valid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadProfileCache
+(
+    void
+)
+{
+    le_result_t res;
+
+    if (IsProfileCacheValid)
+    {
+        return LE_OK;
+    }
+
+    memset(ProfileCache, 0, sizeof(ProfileCache));
+
+    res = ReadListing("AT+CGDCONT?", "+CGDCONT:", ParseCgdcontLine);
     if (res != LE_OK)
     {
-        LE_ERROR("Failed to send the command");
         return res;
     }
-    responseStr[0] = NULL_CHAR;
-    res = le_atClient_GetFinalResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
 
+    // Authentication is optional: the contexts stay valid without it
+    if (ReadListing("AT+CGAUTH?", "+CGAUTH:", ParseCgauthLine) != LE_OK)
+    {
+        LE_WARN("Failed to read the PDP contexts authentication");
+    }
+
+    IsProfileCacheValid = true;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the parameters of a PDP context from the profile cache, reading the contexts from the modem
+ * if needed.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_NOT_FOUND     The context is not defined on the modem.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_utils_GetCachedProfile
+(
+    uint32_t              profileIndex,     ///< [IN]  The profile to use
+    pa_mdc_ProfileData_t* profileDataPtr    ///< [OUT] The profile data
+)
+{
+    le_result_t res;
+
+    if ((!profileIndex) || (profileIndex > PA_MDC_MAX_PROFILE) || (!profileDataPtr))
+    {
+        LE_DEBUG("Invalid parameter");
+        return LE_BAD_PARAMETER;
+    }
+
+    res = LoadProfileCache();
     if (res != LE_OK)
     {
-        LE_ERROR("Failed to get the final response");
-        le_atClient_Delete(cmdRef);
         return res;
     }
-    else if (strcmp(responseStr,"OK") != 0)
+
+    if (!ProfileCache[profileIndex].isDefined)
     {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
-        return LE_FAULT;
+        return LE_NOT_FOUND;
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
+    *profileDataPtr = ProfileCache[profileIndex].profileData;
 
-    le_atClient_Delete(cmdRef);
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the profile cache. It must be called each time a PDP context is written.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_mdc_utils_InvalidateProfileCache
+(
+    void
+)
+{
+    IsProfileCacheValid = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to retrieve the PDP type from PDP Context
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_utils_GetPDPType
+(
+    uint32_t profileIndex,               ///< [IN]  The profile to use
+    le_mdc_Pdp_t *pdpTypePtr             ///< [OUT] The PDP Type
+)
+{
+    pa_mdc_ProfileData_t profileData;
+    le_result_t          res;
+
+    if ((!profileIndex) || (!pdpTypePtr))
+    {
+        LE_DEBUG("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
 
     // Default PDP type
     *pdpTypePtr = LE_MDC_PDP_IPV4;
 
-    if (res != LE_OK)
+    res = pa_mdc_utils_GetCachedProfile(profileIndex, &profileData);
+    if (LE_OK == res)
     {
-        LE_ERROR("Failed to get the intermediate response");
+        *pdpTypePtr = profileData.pdp;
     }
-    else
+    else if (LE_NOT_FOUND == res)
     {
-        //  Look for APN string
-        //  AT+CGDCONT?
-        //  +CGDCONT: 1,"<pdp type>","<apn>",,0,0,0,0,0,,0)
-        //  +CGDCONT: 1,"IPV4V6",,,0,0,0,0,0,,0
-        //  +CGDCONT: 2,"IPV4V6","VZWADMIN",,0,0,0,0,0,,0
-        //  Look for the first <">
         res = LE_FAULT;
-        tokenPtr = strtok_r(responseStr, "\"", &savePtr);
-        if(tokenPtr)
-        {
-            LE_DEBUG("tokenPtr1 %s", tokenPtr);
-            tokenPtr = strtok_r(NULL, "\"", &savePtr);
-            if(tokenPtr)
-            {
-                LE_DEBUG("tokenPtr2 %s", tokenPtr);
-                if ( 0 == strcmp(tokenPtr, "IPV4V6") )
-                {
-                    *pdpTypePtr = LE_MDC_PDP_IPV4V6;
-                    res = LE_OK;
-                }
-                else if( 0 == strcmp(tokenPtr, "IPV6") )
-                {
-                    *pdpTypePtr = LE_MDC_PDP_IPV6;
-                    res = LE_OK;
-                }
-                else if( 0 == strcmp(tokenPtr, "IP") )
-                {
-                    *pdpTypePtr = LE_MDC_PDP_IPV4;
-                    res = LE_OK;
-                }
-            }
-        }
     }
 
     return res;
@@ -549,153 +795,311 @@ le_result_t pa_mdc_util_GetDNSAddr
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function must be called to get autentification setting on PDP context
+ * Store an address of the IP parameters snapshot, converted to its display format. The address is
+ * cleared if it does not match the IP version.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StoreAddress
+(
+    char*                  addrStr,     ///< [IN] Address read from the modem
+    le_mdmDefs_IpVersion_t ipVersion,   ///< [IN] IP Version
+    char*                  destStr,     ///< [OUT] Snapshot address
+    size_t                 destStrSize  ///< [IN] Snapshot address size
+)
+{
+    pa_utils_RemoveQuotationString(addrStr);
+
+    if (!pa_mdc_util_CheckConvertIPAddressFormat(addrStr, ipVersion))
+    {
+        destStr[0] = NULL_CHAR;
+        return;
+    }
+
+    if (le_utf8_Copy(destStr, addrStr, destStrSize, NULL) != LE_OK)
+    {
+        LE_WARN("Address %s is too long", addrStr);
+        destStr[0] = NULL_CHAR;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the local addresses of a PDP context with AT+CGPADDR
  *
  * @return LE_OK            The function succeeded.
- * @return LE_BAD_PARAMETER The parameters are invalid.
  * @return LE_TIMEOUT       No response was received.
  * @return LE_FAULT         The function failed.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t pa_mdc_utils_GetAuth
+static le_result_t ReadCgpaddr
 (
-    uint32_t                profileIndex,          ///< [IN]  The profile to use
-    pa_mdc_ProfileData_t*   profileDataPtr
+    uint32_t        cid,                ///< [IN]  The PDP context
+    SessionParam_t* paramPtr            ///< [OUT] The session parameters
 )
 {
-    le_atClient_CmdRef_t    cmdRef   = NULL;
-    char                    responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
-    char*                   tokenPtr = NULL;
-    char*                   savePtr  = NULL;
-    char                    logStr[PA_MDC_LOCAL_STRING_SIZE] = {0};
-    char                    pwdStr[PA_MDC_LOCAL_STRING_SIZE] = {0};
-    int                     val = 0;
-    le_result_t             res = LE_OK;
-
-    if (!profileIndex)
-    {
-        LE_DEBUG("One parameter is NULL");
-        return LE_BAD_PARAMETER;
-    }
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res;
+    char                 commandStr[PA_AT_LOCAL_SHORT_SIZE];
+    char                 responseStr[PA_AT_LOCAL_LONG_STRING_SIZE] = {0};
+    uint32_t             numParam;
+    uint32_t             i;
 
-    /*
-     * AT+CGAUTH? 3GPP At command
-     * [+CGAUTH: <cid>,<auth_prot>,<userid>,<password>]
-     * [<CR><LF>+CGAUTH: <cid>,<auth_prot>,<userid>,<password>
-     * [...]]
-     * +CGAUTH: 1,1,,
-     * +CGAUTH: 2,1,,
-     * +CGAUTH: 7,2,loging,passwd
-     * OK
-     * at+cgauth=?
-     * +CGAUTH : (1 - 15),(NONE, PAP, CHAP),<username>,<password>
-     * OK
-     *
-     */
-    snprintf(responseStr, PA_AT_LOCAL_STRING_SIZE, "+CGAUTH: %"PRIu32, profileIndex);
+    // 3GPP 27.007
+    // AT+CGPADDR=1
+    // +CGPADDR: 1,"10.29.164.168","254.128.0.0.0.0.0.0.90.159.101.12.150.163.37.78"
+    snprintf(commandStr, sizeof(commandStr), "AT+CGPADDR=%"PRIu32, cid);
 
     res = le_atClient_SetCommandAndSend(&cmdRef,
-        pa_utils_GetAtDeviceRef(),
-        "AT+CGAUTH?",
-        responseStr,
-        DEFAULT_AT_RESPONSE,
-        DEFAULT_AT_CMD_TIMEOUT);
+                                        pa_utils_GetAtDeviceRef(),
+                                        commandStr,
+                                        "+CGPADDR:",
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
     if (res != LE_OK)
     {
         LE_ERROR("Failed to send the command");
         return res;
     }
 
-    responseStr[0] = NULL_CHAR;
-    res = le_atClient_GetFinalResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
-
-    if (res != LE_OK)
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    if ((res != LE_OK) || (strcmp(responseStr, "OK") != 0))
     {
         LE_ERROR("Failed to get the final response");
         le_atClient_Delete(cmdRef);
-        return res;
+        return LE_FAULT;
     }
-    else if (strcmp(responseStr,"OK") != 0)
+
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    le_atClient_Delete(cmdRef);
+    if (res != LE_OK)
     {
-        LE_ERROR("Final response is not OK");
-        le_atClient_Delete(cmdRef);
+        LE_ERROR("Failed to get the intermediate response");
         return LE_FAULT;
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
+    // The IPv4 and IPv6 addresses can be given in any order
+    numParam = pa_utils_CountAndIsolateLineParameters(responseStr);
+    for (i = 3; i <= numParam; i++)
+    {
+        char* addrStr = pa_utils_IsolateLineParameter(responseStr, i);
 
-    le_atClient_Delete(cmdRef);
+        pa_utils_RemoveQuotationString(addrStr);
+        if (NULL_CHAR == addrStr[0])
+        {
+            continue;
+        }
 
+        if (pa_mdc_util_CheckConvertIPAddressFormat(addrStr, LE_MDMDEFS_IPV4))
+        {
+            StoreAddress(addrStr, LE_MDMDEFS_IPV4,
+                         paramPtr->ipv4.addr, sizeof(paramPtr->ipv4.addr));
+        }
+        else
+        {
+            StoreAddress(addrStr, LE_MDMDEFS_IPV6,
+                         paramPtr->ipv6.addr, sizeof(paramPtr->ipv6.addr));
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the gateway and DNS addresses of a PDP context with AT+CGCONTRDP. A dual stack context
+ * returns one line per IP version.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadCgcontrdp
+(
+    uint32_t        cid,                ///< [IN]  The PDP context
+    SessionParam_t* paramPtr            ///< [OUT] The session parameters
+)
+{
+    le_atClient_CmdRef_t    cmdRef = NULL;
+    le_result_t             res;
+    char                    commandStr[PA_AT_LOCAL_SHORT_SIZE];
+    char                    responseStr[PA_AT_LOCAL_LONG_STRING_SIZE] = {0};
+    char                    lineStr[PA_AT_LOCAL_LONG_STRING_SIZE];
+    char                    gwStr[PA_MDC_LOCAL_STRING_SIZE];
+    char                    dns1Str[PA_MDC_LOCAL_STRING_SIZE];
+    char                    dns2Str[PA_MDC_LOCAL_STRING_SIZE];
+    pa_mdc_utils_IpParam_t* ipParamPtr;
+    le_mdmDefs_IpVersion_t  ipVersion;
+    int                     nbDot;
+
+    snprintf(commandStr, sizeof(commandStr), "AT+CGCONTRDP=%"PRIu32, cid);
+
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        commandStr,
+                                        "+CGCONTRDP:",
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
     if (res != LE_OK)
     {
-        LE_WARN("Failed to get the intermediate response");
+        LE_ERROR("Failed to send the command");
+        return res;
     }
-    else
+
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    if ((res != LE_OK) || (strcmp(responseStr, "OK") != 0))
+    {
+        LE_ERROR("Failed to get the final response");
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
+
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    while (LE_OK == res)
     {
-        profileDataPtr->authentication.type = LE_MDC_AUTH_NONE;
-        //  Look for the first <,>
-        tokenPtr = strtok_r(responseStr + strlen("+CGAUTH: "), ",", &savePtr);
-        if(tokenPtr)
+        // The IP version of the line is given by its "address.mask" field: 7 dots for IPv4
+        le_utf8_Copy(lineStr, responseStr, sizeof(lineStr), NULL);
+        if (pa_utils_CountAndIsolateLineParameters(lineStr) >= 5)
         {
-            LE_DEBUG("tokenPtr %s", tokenPtr);
-            val = atoi(tokenPtr);
-            if (val != profileIndex)
+            nbDot = CountMyChar(pa_utils_IsolateLineParameter(lineStr, 5), DOT_CHAR);
+            ipVersion = ((2 * NB_DOT_IPV4_ADDR + 1) == nbDot) || (NB_DOT_IPV4_ADDR == nbDot) ?
+                        LE_MDMDEFS_IPV4 : LE_MDMDEFS_IPV6;
+            ipParamPtr = (LE_MDMDEFS_IPV4 == ipVersion) ? &paramPtr->ipv4 : &paramPtr->ipv6;
+
+            if (LE_OK == pa_mdc_util_GetGWAddr(responseStr, gwStr, sizeof(gwStr)))
             {
-                return LE_FAULT;
+                StoreAddress(gwStr, ipVersion, ipParamPtr->gw, sizeof(ipParamPtr->gw));
             }
 
-            tokenPtr = strtok_r(NULL, ",", &savePtr);
-            if(tokenPtr)
+            if (LE_OK == pa_mdc_util_GetDNSAddr(responseStr,
+                                                dns1Str, sizeof(dns1Str),
+                                                dns2Str, sizeof(dns2Str)))
             {
-                LE_DEBUG("tokenPtr %s", tokenPtr);
-                val = atoi(tokenPtr);
-                switch(val)
-                {
-                    case 0:
-                        LE_DEBUG("Auth none");
-                        profileDataPtr->authentication.type = LE_MDC_AUTH_NONE;
-                        break;
-                    case 1:
-                        LE_DEBUG("Auth pap");
-                        profileDataPtr->authentication.type = LE_MDC_AUTH_PAP;
-                        break;
-                    case 2:
-                        LE_DEBUG("Auth chap");
-                        profileDataPtr->authentication.type = LE_MDC_AUTH_CHAP;
-                        break;
-                    default:
-                        LE_DEBUG("Auth Faild %d", val);
-                        return LE_FAULT;
-                }
-
-                tokenPtr = strtok_r(NULL, ",", &savePtr);
-                if(tokenPtr)
-                {
-                    LE_DEBUG("Log  %s", tokenPtr);
-                    snprintf(logStr, PA_MDC_LOCAL_STRING_SIZE, "%s", tokenPtr);
-
-                    tokenPtr = strtok_r(NULL, ",", &savePtr);
-                    if(tokenPtr)
-                    {
-                        LE_DEBUG("Pwd %s", tokenPtr);
-                        snprintf(pwdStr, PA_MDC_LOCAL_STRING_SIZE, "%s", tokenPtr);
-                    }
-                    else
-                    {
-                        LE_DEBUG("Pwd NULL");
-                    }
-                }
+                StoreAddress(dns1Str, ipVersion, ipParamPtr->dns1, sizeof(ipParamPtr->dns1));
+                StoreAddress(dns2Str, ipVersion, ipParamPtr->dns2, sizeof(ipParamPtr->dns2));
             }
         }
-        pa_utils_RemoveQuotationString(logStr);
-        pa_utils_RemoveQuotationString(pwdStr);
-        strncpy(profileDataPtr->authentication.userName, logStr, PA_MDC_USERNAME_MAX_BYTES);
-        strncpy(profileDataPtr->authentication.password, pwdStr, PA_MDC_PWD_MAX_BYTES);
+
+        res = le_atClient_GetNextIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    }
+
+    le_atClient_Delete(cmdRef);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the dynamic IP parameters of a data session. They are read once from AT+CGPADDR and
+ * AT+CGCONTRDP and served from memory until the snapshot is invalidated.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_utils_GetIpParam
+(
+    uint32_t                profileIndex,   ///< [IN]  The profile to use
+    le_mdmDefs_IpVersion_t  ipVersion,      ///< [IN]  IP Version
+    pa_mdc_utils_IpParam_t* ipParamPtr      ///< [OUT] The IP parameters
+)
+{
+    SessionParam_t* paramPtr;
+    uint32_t        cid;
+    le_result_t     res;
+
+    if ((!profileIndex) || (profileIndex > PA_MDC_MAX_PROFILE) || (!ipParamPtr))
+    {
+        LE_DEBUG("Invalid parameter");
+        return LE_BAD_PARAMETER;
+    }
+
+    paramPtr = &SessionParams[profileIndex];
+
+    if (!paramPtr->isValid)
+    {
+        memset(paramPtr, 0, sizeof(SessionParam_t));
+        cid = pa_mdc_local_GetCidFromProfileIndex(profileIndex);
+
+        res = ReadCgpaddr(cid, paramPtr);
+        if (res != LE_OK)
+        {
+            return res;
+        }
+
+        // Gateway and DNS are not provided by all the modems
+        if (ReadCgcontrdp(cid, paramPtr) != LE_OK)
+        {
+            LE_WARN("Failed to read the dynamic parameters of cid %"PRIu32, cid);
+        }
+
+        paramPtr->isValid = true;
+    }
+
+    *ipParamPtr = (LE_MDMDEFS_IPV4 == ipVersion) ? paramPtr->ipv4 : paramPtr->ipv6;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the dynamic IP parameters snapshot of a data session, or of all of them when
+ * profileIndex is 0. It must be called on each PDP context event.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_mdc_utils_InvalidateIpParam
+(
+    uint32_t profileIndex                   ///< [IN] The profile to use, 0 for all
+)
+{
+    uint32_t i;
+
+    for (i = 1; i <= PA_MDC_MAX_PROFILE; i++)
+    {
+        if ((!profileIndex) || (i == profileIndex))
+        {
+            SessionParams[i].isValid = false;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to get autentification setting on PDP context
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mdc_utils_GetAuth
+(
+    uint32_t                profileIndex,          ///< [IN]  The profile to use
+    pa_mdc_ProfileData_t*   profileDataPtr
+)
+{
+    pa_mdc_ProfileData_t profileData;
+    le_result_t          res;
+
+    if ((!profileIndex) || (!profileDataPtr))
+    {
+        LE_DEBUG("One parameter is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    res = pa_mdc_utils_GetCachedProfile(profileIndex, &profileData);
+    if (LE_OK == res)
+    {
+        profileDataPtr->authentication = profileData.authentication;
+    }
+    else if (LE_NOT_FOUND == res)
+    {
+        res = LE_FAULT;
     }
 
     return res;
 }
+
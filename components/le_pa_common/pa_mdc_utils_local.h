@@ -124,4 +124,76 @@ le_result_t pa_mdc_utils_GetAuth
     uint32_t                profileIndex,          ///< [IN]  The profile to use
     pa_mdc_ProfileData_t*   profileDataPtr
 );
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the parameters of a PDP context from the profile cache, reading the contexts from the modem
+ * if needed.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_NOT_FOUND     The context is not defined on the modem.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t pa_mdc_utils_GetCachedProfile
+(
+    uint32_t              profileIndex,     ///< [IN]  The profile to use
+    pa_mdc_ProfileData_t* profileDataPtr    ///< [OUT] The profile data
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the profile cache. It must be called each time a PDP context is written.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void pa_mdc_utils_InvalidateProfileCache
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dynamic IP parameters of a data session, for one IP version
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char addr[LE_MDMDEFS_IPV6_ADDR_MAX_BYTES];  ///< Local IP address
+    char gw[LE_MDMDEFS_IPV6_ADDR_MAX_BYTES];    ///< Gateway address
+    char dns1[LE_MDMDEFS_IPV6_ADDR_MAX_BYTES];  ///< Primary DNS address
+    char dns2[LE_MDMDEFS_IPV6_ADDR_MAX_BYTES];  ///< Secondary DNS address
+}
+pa_mdc_utils_IpParam_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the dynamic IP parameters of a data session. They are read once from AT+CGPADDR and
+ * AT+CGCONTRDP and served from memory until the snapshot is invalidated.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t pa_mdc_utils_GetIpParam
+(
+    uint32_t                profileIndex,   ///< [IN]  The profile to use
+    le_mdmDefs_IpVersion_t  ipVersion,      ///< [IN]  IP Version
+    pa_mdc_utils_IpParam_t* ipParamPtr      ///< [OUT] The IP parameters
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the dynamic IP parameters snapshot of a data session, or of all of them when
+ * profileIndex is 0. It must be called on each PDP context event.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void pa_mdc_utils_InvalidateIpParam
+(
+    uint32_t profileIndex                   ///< [IN] The profile to use, 0 for all
+);
+
 #endif // LEGATO_PAMDCUTILSLOCAL_INCLUDE_GUARD
@@ -34,20 +34,82 @@
 //--------------------------------------------------------------------------------------------------
 #define DEFAULT_PSSTATE_POOL_SIZE  8
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool default value for Radio Access Technology change
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_RATCHANGE_POOL_SIZE  8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of an unknown <AcT>
+ */
+//--------------------------------------------------------------------------------------------------
+#define ACT_UNKNOWN                -1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool default value for signal strength indication
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_SSIND_POOL_SIZE    4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of Radio Access Technologies supporting signal strength indications
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIGNAL_IND_RAT_COUNT       (LE_MRC_RAT_CDMA + 1)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal sampling intervals in ms. The sampling interval doubles from the minimum up to the maximum
+ * while no indication is reported. When the modem reports signal indicator changes through +CIEV,
+ * the sampling only runs at the maximum interval as a fallback.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIGNAL_SAMPLE_MIN_MS       5000
+#define SIGNAL_SAMPLE_MAX_MS       60000
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of expected networks
  */
 //--------------------------------------------------------------------------------------------------
-#define HIGH_SCAN_INFO_COUNT 1
+#define HIGH_SCAN_INFO_COUNT 64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the hash table used to remove the duplicated networks of a scan. Must be a power of two
+ * greater than HIGH_SCAN_INFO_COUNT.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SCAN_HASH_SIZE       128
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Maximum number of expected cells.
+ * Maximum number of neighbor cells collected.
  */
 //--------------------------------------------------------------------------------------------------
-#define HIGH_CELL_INFO_COUNT       6
+#define MAX_NEIGHBOR_CELLS         6
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of expected cells: the collected neighbor cells, and the cells still held by the
+ * caller of the previous collection.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HIGH_CELL_INFO_COUNT       (2 * MAX_NEIGHBOR_CELLS)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of fields of a neighbor cell in +CCED:
+ * <MCC>,<MNC>,<LAC>,<CI>,<BSIC>,<BCCH Freq>,<RxLev>
+ */
+//--------------------------------------------------------------------------------------------------
+#define CCED_NEIGHBOR_FIELD_COUNT  7
 
 
 //--------------------------------------------------------------------------------------------------
@@ -68,6 +130,24 @@ LE_MEM_DEFINE_STATIC_POOL(PSStatePool,
                           DEFAULT_PSSTATE_POOL_SIZE,
                           sizeof(le_mrc_NetRegState_t));
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Define static pool for Radio Access Technology change
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(RatChangePool,
+                          DEFAULT_RATCHANGE_POOL_SIZE,
+                          sizeof(le_mrc_Rat_t));
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Define static pool for signal strength indication
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(SsIndPool,
+                          DEFAULT_SSIND_POOL_SIZE,
+                          sizeof(pa_mrc_SignalStrengthIndication_t));
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Define static pool for scan information
@@ -102,6 +182,13 @@ static le_mem_PoolRef_t           RegStatePoolRef = NULL;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t           PSStatePoolRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool reference for Radio Access Technology change
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t           RatChangePoolRef = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The pa_mrc_ScanInformation_t pool
@@ -111,79 +198,1004 @@ static le_mem_PoolRef_t            ScanInformationPool = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Pool for cells information.
+ * Pool for cells information.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t             CellInfoPool = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A neighbor cell kept between two collections
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pa_mrc_CellInfo_t* cellInfoPtr;     ///< Cell information, NULL if the entry is free
+    uint32_t           channel;         ///< ARFCN / UARFCN / EARFCN of the cell
+    bool               isLent;          ///< The cell information is queued in a caller list
+    bool               isSeen;          ///< The cell was reported by the last collection
+}
+NeighborCell_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A neighbor cell parsed from the cell monitoring command
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pa_mrc_CellInfo_t info;             ///< Cell information
+    uint32_t          channel;          ///< ARFCN / UARFCN / EARFCN of the cell
+}
+ParsedCell_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parser of a cell monitoring response line
+ *
+ * @return The number of cells added to the cells array
+ */
+//--------------------------------------------------------------------------------------------------
+typedef int (*CellLineParser_t)
+(
+    char*         lineStr,              ///< [IN] The response line
+    ParsedCell_t* cellsPtr,             ///< [OUT] The parsed cells
+    int           maxCells              ///< [IN] The number of free entries in the cells array
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cell monitoring command
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*      commandStr;        ///< Command to send
+    const char*      interStr;          ///< Intermediate response prefix
+    CellLineParser_t lineParser;        ///< Parser of an intermediate response
+}
+CellMonitorCommand_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Neighbor cells kept between two collections
+ */
+//--------------------------------------------------------------------------------------------------
+static NeighborCell_t NeighborCells[MAX_NEIGHBOR_CELLS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cell monitoring command used to collect the neighbor cells
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_mrc_CellMonitorProfile_t CellMonitorProfile = PA_MRC_CELL_MONITOR_NONE;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Networks found by a network scan, indexed by a hash of (MCC, MNC, RAT)
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_List_t*            listPtr;                  ///< List of the networks found
+    pa_mrc_ScanInformation_t* table[SCAN_HASH_SIZE];    ///< Hash table of the networks found
+    uint32_t                  count;                    ///< Number of networks found
+}
+ScanContext_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called for each new network found by a network scan
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_mrc_ScanProgressHandlerFunc_t ScanProgressHandler = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the network scan progress handler
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ScanProgressContextPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Network registering event identifier
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t                NetworkRegEventId = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *Packet Switched state event identifier
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t                PSStateEventId = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Radio Access Technology change event identifier
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t                RatChangeEventId = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Network registering mode
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_mrc_NetworkRegSetting_t RegNotification = PA_MRC_DISABLE_REG_NOTIFICATION;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Packet Switched state.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mrc_NetRegState_t PSState = LE_MRC_REG_UNKNOWN;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * <AcT> of the serving cell, as last reported by the modem.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CurrentAct = ACT_UNKNOWN;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal strength indication settings and state of a Radio Access Technology
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool     hasThresholds;     ///< Thresholds are set
+    int32_t  lowerThreshold;    ///< Lower-range threshold in dBm
+    int32_t  upperThreshold;    ///< Upper-range threshold in dBm
+    uint16_t delta;             ///< Delta in units of 0.1 dB, 0 if not set
+    bool     hasReference;      ///< A reference signal strength is known
+    int32_t  referenceSs;       ///< Last reported signal strength in units of 0.1 dB
+    int      referenceRange;    ///< Range of the last reported signal strength
+}
+SignalIndConfig_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal strength indication settings, per Radio Access Technology
+ */
+//--------------------------------------------------------------------------------------------------
+static SignalIndConfig_t SignalIndConfig[SIGNAL_IND_RAT_COUNT];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool reference for signal strength indication
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t SsIndPoolRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal strength indication event identifier
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t SsIndEventId = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of signal strength indication handlers
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t SsIndHandlerCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer sampling the signal strength
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t SignalSampleTimerRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Current signal sampling interval in ms
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t SignalSampleIntervalMs = SIGNAL_SAMPLE_MIN_MS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index of the "signal" indicator in AT+CIND, 0 if not supported, -1 if not read yet
+ */
+//--------------------------------------------------------------------------------------------------
+static int SignalCindIndex = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited +CIEV references
+ */
+//--------------------------------------------------------------------------------------------------
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCievRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Radio Access Technology of the serving cell.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mrc_Rat_t CurrentRat = LE_MRC_RAT_UNKNOWN;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited +CEREG references
+ */
+//--------------------------------------------------------------------------------------------------
+static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCeregRef = NULL;
+
+#ifdef MK_CONFIG_MRC_LISTEN_ATSWI_READY
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback for AtSwi ready
+ *
+ * @return none
+ */
+//--------------------------------------------------------------------------------------------------
+static void AtSwiReadyHandlerFunc(const sig_event_msg_t * const psig_event_msg)
+{
+    if ( psig_event_msg != NULL )
+    {
+        switch ( psig_event_msg->sig_usr_event )
+        {
+            case SIG_ATCMD_READY:
+                if ( psig_event_msg->logportApp == LEGATO )
+                {
+                    le_mrc_NetRegState_t* stateArgPtr = (le_mrc_NetRegState_t*)
+                                                        psig_event_msg->user_arg;
+                    le_mrc_NetRegState_t* statePtr = le_mem_ForceAlloc(RegStatePoolRef);
+                    *statePtr = *stateArgPtr;
+                    LE_INFO("AtSwiReadyHandlerFunc state = %d", *stateArgPtr);
+                    le_event_ReportWithRefCounting(NetworkRegEventId, statePtr);
+                }
+                break;
+            case SIG_ATCMD_REG_FAILURE:
+                break;
+            default:
+                break;
+        }
+    }
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert an <AcT> parameter of +CREG / +CEREG / +COPS.
+ *
+ * @return The <AcT> value, ACT_UNKNOWN if the parameter is empty or invalid
+ */
+//--------------------------------------------------------------------------------------------------
+static int ParseAct
+(
+    const char* actStr          ///< [IN] The <AcT> parameter
+)
+{
+    char* endPtr = NULL;
+    long  act;
+
+    if ((NULL == actStr) || (NULL_CHAR == actStr[0]))
+    {
+        return ACT_UNKNOWN;
+    }
+
+    act = strtol(actStr, &endPtr, BASE_10);
+    if ((endPtr == actStr) || (act < 0) || (act > INT_MAX))
+    {
+        return ACT_UNKNOWN;
+    }
+
+    return (int)act;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the <AcT> of the serving cell, and report a Radio Access Technology change to the event
+ * loop.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateAccessTechnology
+(
+    int act                     ///< [IN] The new <AcT>, ACT_UNKNOWN if not registered
+)
+{
+    le_mrc_Rat_t  rat = LE_MRC_RAT_UNKNOWN;
+    le_mrc_Rat_t* ratPtr;
+
+    if (act == CurrentAct)
+    {
+        return;
+    }
+
+    LE_DEBUG("<AcT> %d -> %d", CurrentAct, act);
+    CurrentAct = act;
+
+    if (ACT_UNKNOWN != act)
+    {
+        pa_mrc_local_ConvertActToRat(act, &rat);
+    }
+
+    if (rat == CurrentRat)
+    {
+        return;
+    }
+
+    CurrentRat = rat;
+
+    LE_DEBUG("Send Event with RAT %d", rat);
+
+    ratPtr = le_mem_ForceAlloc(RatChangePoolRef);
+    *ratPtr = rat;
+    le_event_ReportWithRefCounting(RatChangeEventId, ratPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the <AcT> of the serving cell with AT+COPS?
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_TIMEOUT       No response was received.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadCurrentAct
+(
+    void
+)
+{
+    char        responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
+    le_result_t res;
+
+    // +COPS: <mode>[,<format>,<oper>[,<AcT>]]
+    res = pa_utils_GetATIntermediateResponse("AT+COPS?", "+COPS:",
+                                             responseStr, sizeof(responseStr));
+    if (LE_OK != res)
+    {
+        return res;
+    }
+
+    if (pa_utils_CountAndIsolateLineParameters(responseStr) >= COPS_PARAM_ACT_COUNT_ID)
+    {
+        UpdateAccessTechnology(ParseAct(pa_utils_IsolateLineParameter(responseStr,
+                                                                      COPS_PARAM_ACT_COUNT_ID)));
+    }
+    else
+    {
+        UpdateAccessTechnology(ACT_UNKNOWN);
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the range of a signal strength relative to the thresholds
+ *
+ * @return 0 under the lower-range threshold, 2 over the upper-range threshold, 1 in between
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetSignalRange
+(
+    const SignalIndConfig_t* configPtr, ///< [IN] The signal strength indication settings
+    int32_t                  ss         ///< [IN] The signal strength in dBm
+)
+{
+    if (ss <= configPtr->lowerThreshold)
+    {
+        return 0;
+    }
+    else if (ss >= configPtr->upperThreshold)
+    {
+        return 2;
+    }
+
+    return 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the signal and report a signal strength indication when a threshold is crossed or when
+ * the signal strength moved by the delta since the last indication.
+ *
+ * @return true if an indication was reported
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SampleSignalStrength
+(
+    void
+)
+{
+    pa_mrc_SignalMetrics_t             metrics;
+    pa_mrc_SignalStrengthIndication_t* ssIndPtr;
+    SignalIndConfig_t*                 configPtr;
+    int32_t                            ss;
+    int                                range = 1;
+    bool                               isReport = false;
+
+    if (LE_OK != pa_mrc_MeasureSignalMetrics(&metrics))
+    {
+        return false;
+    }
+
+    if ((metrics.rat <= LE_MRC_RAT_UNKNOWN) || (metrics.rat >= SIGNAL_IND_RAT_COUNT))
+    {
+        return false;
+    }
+
+    configPtr = &SignalIndConfig[metrics.rat];
+
+    // Compare with 1 decimal place when the modem provides it
+    if ((LE_MRC_RAT_LTE == metrics.rat) && (INT32_MAX != metrics.lteMetrics.rsrp))
+    {
+        ss = metrics.lteMetrics.rsrp;
+    }
+    else
+    {
+        ss = metrics.ss * 10;
+    }
+
+    if (configPtr->hasThresholds)
+    {
+        range = GetSignalRange(configPtr, metrics.ss);
+    }
+
+    if (configPtr->hasReference)
+    {
+        if ((configPtr->hasThresholds) && (range != configPtr->referenceRange))
+        {
+            isReport = true;
+        }
+        if ((configPtr->delta) && (abs(ss - configPtr->referenceSs) >= configPtr->delta))
+        {
+            isReport = true;
+        }
+    }
+
+    if ((configPtr->hasReference) && (!isReport))
+    {
+        return false;
+    }
+
+    configPtr->hasReference = true;
+    configPtr->referenceSs = ss;
+    configPtr->referenceRange = range;
+
+    if (!isReport)
+    {
+        return false;
+    }
+
+    LE_DEBUG("Send Event with RAT %d, ss %"PRIi32" dBm", metrics.rat, metrics.ss);
+
+    ssIndPtr = le_mem_ForceAlloc(SsIndPoolRef);
+    memset(ssIndPtr, 0, sizeof(pa_mrc_SignalStrengthIndication_t));
+    ssIndPtr->rat = metrics.rat;
+    ssIndPtr->ss = metrics.ss;
+    if (LE_MRC_RAT_LTE == metrics.rat)
+    {
+        ssIndPtr->rsrq = metrics.lteMetrics.rsrq;
+        ssIndPtr->rsrp = metrics.lteMetrics.rsrp;
+        ssIndPtr->snr = metrics.lteMetrics.snr;
+    }
+    le_event_ReportWithRefCounting(SsIndEventId, ssIndPtr);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal sampling timer handler.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void SignalSampleTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    if (SampleSignalStrength() || (SignalCindIndex > 0))
+    {
+        SignalSampleIntervalMs = (SignalCindIndex > 0) ? SIGNAL_SAMPLE_MAX_MS :
+                                                         SIGNAL_SAMPLE_MIN_MS;
+    }
+    else if (SignalSampleIntervalMs < SIGNAL_SAMPLE_MAX_MS)
+    {
+        SignalSampleIntervalMs *= 2;
+        if (SignalSampleIntervalMs > SIGNAL_SAMPLE_MAX_MS)
+        {
+            SignalSampleIntervalMs = SIGNAL_SAMPLE_MAX_MS;
+        }
+    }
+
+    le_timer_SetMsInterval(timerRef, SignalSampleIntervalMs);
+    le_timer_Start(timerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The handler for a +CIEV indicator event.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void CievUnsolHandler
+(
+    const char* unsolPtr,
+    void* contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    // +CIEV: <ind>,<value>
+    if ((NULL == unsolPtr) ||
+        (pa_utils_CountAndIsolateLineParameters((char*) unsolPtr) < 3) ||
+        (atoi(pa_utils_IsolateLineParameter(unsolPtr, 2)) != SignalCindIndex))
+    {
+        return;
+    }
+
+    SampleSignalStrength();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the index of the "signal" indicator from AT+CIND=?
+ *
+ * @return The indicator index, 0 if not supported
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetCindSignalIndex
+(
+    void
+)
+{
+    char  responseStr[LE_ATDEFS_RESPONSE_MAX_BYTES] = {0};
+    char* ptr;
+    int   index = 0;
+
+    // +CIND: ("battchg",(0-5)),("signal",(0-5)),("service",(0-1)),...
+    if (LE_OK != pa_utils_GetATIntermediateResponse("AT+CIND=?", "+CIND:",
+                                                    responseStr, sizeof(responseStr)))
+    {
+        return 0;
+    }
+
+    ptr = responseStr;
+    while ((ptr = strstr(ptr, "(\"")) != NULL)
+    {
+        index++;
+        ptr += strlen("(\"");
+        if (0 == strncmp(ptr, "signal\"", strlen("signal\"")))
+        {
+            return index;
+        }
+    }
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start or stop the signal strength monitoring, depending on the registered handlers and the
+ * configured thresholds and deltas.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateSignalMonitoring
+(
+    void
+)
+{
+    bool   isNeeded = false;
+    int    i;
+
+    for (i = 0; (i < SIGNAL_IND_RAT_COUNT) && (SsIndHandlerCount); i++)
+    {
+        if ((SignalIndConfig[i].hasThresholds) || (SignalIndConfig[i].delta))
+        {
+            isNeeded = true;
+        }
+    }
+
+    if (isNeeded == le_timer_IsRunning(SignalSampleTimerRef))
+    {
+        return;
+    }
+
+    if (!isNeeded)
+    {
+        LE_DEBUG("Stop signal monitoring");
+        le_timer_Stop(SignalSampleTimerRef);
+        if (UnsolCievRef)
+        {
+            le_atClient_RemoveUnsolicitedResponseHandler(UnsolCievRef);
+            UnsolCievRef = NULL;
+            pa_utils_SendATCommandOK("AT+CMER=3,0,0,0");
+        }
+        return;
+    }
+
+    LE_DEBUG("Start signal monitoring");
+
+    if (SignalCindIndex < 0)
+    {
+        SignalCindIndex = GetCindSignalIndex();
+    }
+
+    // Use the modem indicator events where available
+    if (SignalCindIndex > 0)
+    {
+        if (LE_OK == pa_utils_SendATCommandOK("AT+CMER=3,0,0,1"))
+        {
+            UnsolCievRef = le_atClient_AddUnsolicitedResponseHandler("+CIEV:",
+                                                                     pa_utils_GetAtDeviceRef(),
+                                                                     CievUnsolHandler,
+                                                                     NULL,
+                                                                     1);
+        }
+        else
+        {
+            LE_WARN("+CIEV not available, sample the signal strength");
+            SignalCindIndex = 0;
+        }
+    }
+
+    for (i = 0; i < SIGNAL_IND_RAT_COUNT; i++)
+    {
+        SignalIndConfig[i].hasReference = false;
+    }
+    SampleSignalStrength();
+
+    SignalSampleIntervalMs = (SignalCindIndex > 0) ? SIGNAL_SAMPLE_MAX_MS : SIGNAL_SAMPLE_MIN_MS;
+    le_timer_SetMsInterval(SignalSampleTimerRef, SignalSampleIntervalMs);
+    le_timer_Start(SignalSampleTimerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an integer parameter of a cell monitoring response.
+ *
+ * @return true if the parameter is present and valid
  */
 //--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t             CellInfoPool = NULL;
+static bool GetCellParam
+(
+    const char* paramStr,       ///< [IN] The parameter
+    int         base,           ///< [IN] The numeric base of the parameter
+    int32_t*    valuePtr        ///< [OUT] The parameter value
+)
+{
+    char* endPtr = NULL;
+    long  value;
+
+    if ((NULL == paramStr) || (NULL_CHAR == paramStr[0]))
+    {
+        return false;
+    }
+
+    value = strtol(paramStr, &endPtr, base);
+    if ((endPtr == paramStr) || (value < INT32_MIN) || (value > INT32_MAX))
+    {
+        return false;
+    }
+
+    *valuePtr = (int32_t)value;
+    return true;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Network registering event identifier
+ * Parse a +CCED: line holding up to six GSM neighbor cells.
+ * +CCED: <MCC>,<MNC>,<LAC>,<CI>,<BSIC>,<BCCH Freq>,<RxLev>[,<MCC>,...]
+ *
+ * @return The number of cells added to the cells array
  */
 //--------------------------------------------------------------------------------------------------
-static le_event_Id_t                NetworkRegEventId = NULL;
+static int ParseCcedLine
+(
+    char*         lineStr,              ///< [IN] The response line
+    ParsedCell_t* cellsPtr,             ///< [OUT] The parsed cells
+    int           maxCells              ///< [IN] The number of free entries in the cells array
+)
+{
+    uint32_t numParam = pa_utils_CountAndIsolateLineParameters(lineStr);
+    uint32_t pos;
+    int      count = 0;
+    int32_t  lac, ci, freq, rxlev;
+
+    for (pos = 2; ((pos + CCED_NEIGHBOR_FIELD_COUNT - 1) <= numParam) && (count < maxCells);
+         pos += CCED_NEIGHBOR_FIELD_COUNT)
+    {
+        // LAC and CI are reported in hexadecimal, empty fields for an unknown neighbor
+        if ((!GetCellParam(pa_utils_IsolateLineParameter(lineStr, pos + 2), 16, &lac)) ||
+            (!GetCellParam(pa_utils_IsolateLineParameter(lineStr, pos + 3), 16, &ci)))
+        {
+            continue;
+        }
+
+        memset(&cellsPtr[count], 0, sizeof(ParsedCell_t));
+        cellsPtr[count].info.rat = LE_MRC_RAT_GSM;
+        cellsPtr[count].info.lac = (uint16_t)lac;
+        cellsPtr[count].info.id = (uint32_t)ci;
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, pos + 5), 10, &freq))
+        {
+            cellsPtr[count].channel = (uint32_t)freq;
+        }
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, pos + 6), 10, &rxlev))
+        {
+            // RXLEV: 0 < -110 dBm, n: -111+n dBm
+            cellsPtr[count].info.rxLevel = (int16_t)(rxlev - 111);
+        }
+        count++;
+    }
+
+    return count;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- *Packet Switched state event identifier
+ * Parse a +QENG: neighbor cell line.
+ * +QENG: "neighbourcell intra","LTE",<earfcn>,<pcid>,<rsrq>,<rsrp>,<rssi>,...
+ * +QENG: "neighbourcell inter","LTE",<earfcn>,<pcid>,<rsrq>,<rsrp>,<rssi>,...
+ * +QENG: "neighbourcell","WCDMA",<uarfcn>,<cell_resel_priority>,<thresh_Xhigh>,<thresh_Xlow>,
+ *        <psc>,<rscp>,<ecno>,...
+ * +QENG: "neighbourcell","GSM",<mcc>,<mnc>,<lac>,<cellid>,<bsic>,<arfcn>,<rxlev>,...
+ *
+ * @return The number of cells added to the cells array
  */
 //--------------------------------------------------------------------------------------------------
-static le_event_Id_t                PSStateEventId = NULL;
+static int ParseQengLine
+(
+    char*         lineStr,              ///< [IN] The response line
+    ParsedCell_t* cellsPtr,             ///< [OUT] The parsed cells
+    int           maxCells              ///< [IN] The number of free entries in the cells array
+)
+{
+    uint32_t      numParam = pa_utils_CountAndIsolateLineParameters(lineStr);
+    ParsedCell_t* cellPtr = cellsPtr;
+    char*         typeStr;
+    char*         ratStr;
+    int32_t       channel, id, lac, value;
+
+    if ((maxCells < 1) || (numParam < 5))
+    {
+        return 0;
+    }
+
+    typeStr = pa_utils_IsolateLineParameter(lineStr, 2);
+    ratStr = pa_utils_IsolateLineParameter(lineStr, 3);
+    pa_utils_RemoveQuotationString(typeStr);
+    pa_utils_RemoveQuotationString(ratStr);
+
+    if (strncmp(typeStr, "neighbourcell", strlen("neighbourcell")) != 0)
+    {
+        return 0;
+    }
+
+    memset(cellPtr, 0, sizeof(ParsedCell_t));
+
+    if ((0 == strcmp(ratStr, "LTE")) && (numParam >= 8) &&
+        GetCellParam(pa_utils_IsolateLineParameter(lineStr, 4), 10, &channel) &&
+        GetCellParam(pa_utils_IsolateLineParameter(lineStr, 5), 10, &id))
+    {
+        bool isIntra = (NULL != strstr(typeStr, "intra"));
+
+        cellPtr->info.rat = LE_MRC_RAT_LTE;
+        cellPtr->info.id = (uint32_t)id;
+        cellPtr->info.lac = UINT16_MAX;
+        cellPtr->channel = (uint32_t)channel;
+        cellPtr->info.lteIntraRsrq = INT32_MAX;
+        cellPtr->info.lteIntraRsrp = INT32_MAX;
+        cellPtr->info.lteInterRsrq = INT32_MAX;
+        cellPtr->info.lteInterRsrp = INT32_MAX;
+
+        // RSRQ and RSRP are reported in dB / dBm, stored with 1 decimal place
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, 6), 10, &value))
+        {
+            *(isIntra ? &cellPtr->info.lteIntraRsrq : &cellPtr->info.lteInterRsrq) = value * 10;
+        }
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, 7), 10, &value))
+        {
+            *(isIntra ? &cellPtr->info.lteIntraRsrp : &cellPtr->info.lteInterRsrp) = value * 10;
+        }
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, 8), 10, &value))
+        {
+            cellPtr->info.rxLevel = (int16_t)value;
+        }
+        return 1;
+    }
+    else if ((0 == strcmp(ratStr, "WCDMA")) && (numParam >= 10) &&
+             GetCellParam(pa_utils_IsolateLineParameter(lineStr, 4), 10, &channel) &&
+             GetCellParam(pa_utils_IsolateLineParameter(lineStr, 8), 10, &id))
+    {
+        cellPtr->info.rat = LE_MRC_RAT_UMTS;
+        cellPtr->info.id = (uint32_t)id;
+        cellPtr->info.lac = UINT16_MAX;
+        cellPtr->channel = (uint32_t)channel;
+        cellPtr->info.umtsEcIo = INT32_MAX;
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, 9), 10, &value))
+        {
+            cellPtr->info.rxLevel = (int16_t)value;
+        }
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, 10), 10, &value))
+        {
+            cellPtr->info.umtsEcIo = value * 10;
+        }
+        return 1;
+    }
+    else if ((0 == strcmp(ratStr, "GSM")) && (numParam >= 10) &&
+             GetCellParam(pa_utils_IsolateLineParameter(lineStr, 6), 16, &lac) &&
+             GetCellParam(pa_utils_IsolateLineParameter(lineStr, 7), 16, &id))
+    {
+        cellPtr->info.rat = LE_MRC_RAT_GSM;
+        cellPtr->info.id = (uint32_t)id;
+        cellPtr->info.lac = (uint16_t)lac;
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, 9), 10, &channel))
+        {
+            cellPtr->channel = (uint32_t)channel;
+        }
+        if (GetCellParam(pa_utils_IsolateLineParameter(lineStr, 10), 10, &value))
+        {
+            cellPtr->info.rxLevel = (int16_t)value;
+        }
+        return 1;
+    }
+
+    return 0;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Network registering mode
+ * Cell monitoring commands, indexed by pa_mrc_CellMonitorProfile_t
  */
 //--------------------------------------------------------------------------------------------------
-static pa_mrc_NetworkRegSetting_t RegNotification = PA_MRC_DISABLE_REG_NOTIFICATION;
+static const CellMonitorCommand_t CellMonitorCommands[] =
+{
+    [PA_MRC_CELL_MONITOR_NONE] = { NULL,                          NULL,      NULL          },
+    [PA_MRC_CELL_MONITOR_CCED] = { "AT+CCED=0,2",                 "+CCED:",  ParseCcedLine },
+    [PA_MRC_CELL_MONITOR_QENG] = { "AT+QENG=\"neighbourcell\"", "+QENG:",  ParseQengLine },
+};
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Packet Switched state.
+ * Check whether a parsed cell is a given cell
+ *
+ * @return true if the cells have the same identity
  */
 //--------------------------------------------------------------------------------------------------
-static le_mrc_NetRegState_t PSState = LE_MRC_REG_UNKNOWN;
+static bool IsSameCell
+(
+    const pa_mrc_CellInfo_t* infoPtr,   ///< [IN] The cell information
+    uint32_t                 channel,   ///< [IN] The cell channel
+    const ParsedCell_t*      cellPtr    ///< [IN] The parsed cell
+)
+{
+    return ((infoPtr->rat == cellPtr->info.rat) && (infoPtr->id == cellPtr->info.id) &&
+            (infoPtr->lac == cellPtr->info.lac) && (channel == cellPtr->channel));
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Unsolicited +CEREG references
+ * Find a kept neighbor cell
+ *
+ * @return The neighbor cell, NULL if not found
  */
 //--------------------------------------------------------------------------------------------------
-static le_atClient_UnsolicitedResponseHandlerRef_t UnsolCeregRef = NULL;
+static NeighborCell_t* FindNeighborCell
+(
+    const ParsedCell_t* cellPtr         ///< [IN] The parsed cell
+)
+{
+    int i;
+
+    for (i = 0; i < MAX_NEIGHBOR_CELLS; i++)
+    {
+        if ((NeighborCells[i].cellInfoPtr) &&
+            (IsSameCell(NeighborCells[i].cellInfoPtr, NeighborCells[i].channel, cellPtr)))
+        {
+            return &NeighborCells[i];
+        }
+    }
+
+    return NULL;
+}
 
-#ifdef MK_CONFIG_MRC_LISTEN_ATSWI_READY
 //--------------------------------------------------------------------------------------------------
 /**
- * Callback for AtSwi ready
+ * Update the kept neighbor cells with a new collection. The cells which are still reported are
+ * updated in place, unless their information is still held by a caller; only the other cells are
+ * allocated.
  *
- * @return none
  */
 //--------------------------------------------------------------------------------------------------
-static void AtSwiReadyHandlerFunc(const sig_event_msg_t * const psig_event_msg)
+static void RefreshNeighborCells
+(
+    const ParsedCell_t* cellsPtr,       ///< [IN] The parsed cells
+    int                 count           ///< [IN] The number of parsed cells, MAX_NEIGHBOR_CELLS max
+)
 {
-    if ( psig_event_msg != NULL )
+    NeighborCell_t* slotPtr[MAX_NEIGHBOR_CELLS] = {NULL};
+    bool            isDuplicate[MAX_NEIGHBOR_CELLS] = {false};
+    int             i, j;
+
+    for (i = 0; i < MAX_NEIGHBOR_CELLS; i++)
     {
-        switch ( psig_event_msg->sig_usr_event )
+        NeighborCells[i].isSeen = false;
+    }
+
+    // Match the reported cells with the kept ones
+    for (i = 0; i < count; i++)
+    {
+        for (j = 0; (j < i) && (!isDuplicate[i]); j++)
         {
-            case SIG_ATCMD_READY:
-                if ( psig_event_msg->logportApp == LEGATO )
-                {
-                    le_mrc_NetRegState_t* stateArgPtr = (le_mrc_NetRegState_t*)
-                                                        psig_event_msg->user_arg;
-                    le_mrc_NetRegState_t* statePtr = le_mem_ForceAlloc(RegStatePoolRef);
-                    *statePtr = *stateArgPtr;
-                    LE_INFO("AtSwiReadyHandlerFunc state = %d", *stateArgPtr);
-                    le_event_ReportWithRefCounting(NetworkRegEventId, statePtr);
-                }
-                break;
-            case SIG_ATCMD_REG_FAILURE:
-                break;
-            default:
-                break;
+            isDuplicate[i] = IsSameCell(&cellsPtr[j].info, cellsPtr[j].channel, &cellsPtr[i]);
+        }
+
+        if (!isDuplicate[i])
+        {
+            slotPtr[i] = FindNeighborCell(&cellsPtr[i]);
+            if (slotPtr[i])
+            {
+                slotPtr[i]->isSeen = true;
+            }
+        }
+    }
+
+    // Release the cells which are not reported anymore
+    for (i = 0; i < MAX_NEIGHBOR_CELLS; i++)
+    {
+        if ((NeighborCells[i].cellInfoPtr) && (!NeighborCells[i].isSeen))
+        {
+            le_mem_Release(NeighborCells[i].cellInfoPtr);
+            NeighborCells[i].cellInfoPtr = NULL;
+            NeighborCells[i].isLent = false;
+        }
+    }
+
+    // Update the kept cells and allocate the new ones
+    for (i = 0; i < count; i++)
+    {
+        if (isDuplicate[i])
+        {
+            continue;
+        }
+
+        for (j = 0; (j < MAX_NEIGHBOR_CELLS) && (NULL == slotPtr[i]); j++)
+        {
+            if (NULL == NeighborCells[j].cellInfoPtr)
+            {
+                slotPtr[i] = &NeighborCells[j];
+            }
+        }
+
+        if (NULL == slotPtr[i])
+        {
+            continue;
+        }
+
+        if (slotPtr[i]->isLent)
+        {
+            le_mem_Release(slotPtr[i]->cellInfoPtr);
+            slotPtr[i]->cellInfoPtr = NULL;
+            slotPtr[i]->isLent = false;
+        }
+
+        if (NULL == slotPtr[i]->cellInfoPtr)
+        {
+            slotPtr[i]->cellInfoPtr = le_mem_TryAlloc(CellInfoPool);
+            if (NULL == slotPtr[i]->cellInfoPtr)
+            {
+                LE_WARN("No more cell information available");
+                continue;
+            }
         }
+
+        *slotPtr[i]->cellInfoPtr = cellsPtr[i].info;
+        slotPtr[i]->cellInfoPtr->link = LE_DLS_LINK_INIT;
+        slotPtr[i]->channel = cellsPtr[i].channel;
+        slotPtr[i]->isSeen = true;
     }
 }
-#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -287,7 +1299,20 @@ static void CeregUnsolHandler
 
     if (numParam >= 2)
     {
-        ReportNetworkPSStateUpdate(atoi(pa_utils_IsolateLineParameter(unsolPtr, 2)));
+        int stat = atoi(pa_utils_IsolateLineParameter(unsolPtr, 2));
+
+        ReportNetworkPSStateUpdate(stat);
+
+        // <AcT> is only meaningful while registered (home or roaming)
+        if ((1 != stat) && (5 != stat))
+        {
+            UpdateAccessTechnology(ACT_UNKNOWN);
+        }
+        else if (numParam >= REG_UNSO_PARAM_POS_ACT_COUNT_ID)
+        {
+            UpdateAccessTechnology(ParseAct(pa_utils_IsolateLineParameter(unsolPtr,
+                                                            REG_UNSO_PARAM_POS_ACT_COUNT_ID)));
+        }
     }
     else
     {
@@ -351,6 +1376,7 @@ static le_result_t GetRegistration
     char*                tokenPtr = NULL;
     char*                savePtr  = NULL;
     char                 responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
+    char                 regStr[PA_AT_LOCAL_STRING_SIZE];
     le_mrc_RatBitMask_t  ratMask = 0;
 
     if (!valuePtr)
@@ -437,6 +1463,8 @@ static le_result_t GetRegistration
     }
     else
     {
+        le_utf8_Copy(regStr, responseStr, sizeof(regStr), NULL);
+
         if ((LE_MRC_BITMASK_RAT_LTE & ratMask) ||
             (LE_MRC_BITMASK_RAT_CATM1 & ratMask) ||
             (LE_MRC_BITMASK_RAT_NB1 & ratMask) ||
@@ -507,6 +1535,19 @@ static le_result_t GetRegistration
                             break;
                     }
                 }
+
+                // +CREG: <n>,<stat>[,[<lac>],[<ci>],[<AcT>]]
+                // <AcT> is only meaningful while registered (home or roaming)
+                if ((LE_MRC_REG_HOME != *valuePtr) && (LE_MRC_REG_ROAMING != *valuePtr))
+                {
+                    UpdateAccessTechnology(ACT_UNKNOWN);
+                }
+                else if (pa_utils_CountAndIsolateLineParameters(regStr) >=
+                         REG_PARAM_POS_ACT_COUNT_ID)
+                {
+                    UpdateAccessTechnology(ParseAct(pa_utils_IsolateLineParameter(regStr,
+                                                                REG_PARAM_POS_ACT_COUNT_ID)));
+                }
             }
         }
         else
@@ -629,51 +1670,248 @@ static void InitializeScanInformation
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Find a Scan information given the mcc and mnc.
+ * Hash the key (MCC, MNC, RAT) of a Scan information.
+ *
+ * @return The hash value
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashScanInformation
+(
+    const char*  mccStr,
+    const char*  mncStr,
+    le_mrc_Rat_t rat
+)
+{
+    // FNV-1a
+    uint32_t    hash = 2166136261u;
+    const char* ptr;
+
+    for (ptr = mccStr; *ptr; ptr++)
+    {
+        hash = (hash ^ (uint8_t)*ptr) * 16777619u;
+    }
+    hash = (hash ^ '-') * 16777619u;
+    for (ptr = mncStr; *ptr; ptr++)
+    {
+        hash = (hash ^ (uint8_t)*ptr) * 16777619u;
+    }
+    hash = (hash ^ (uint32_t)rat) * 16777619u;
+
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the hash table entry of a Scan information given the mcc, mnc and rat.
+ *
+ * @return
+ *      - pointer on the entry holding the Scan information
+ *      - pointer on the free entry where to store it if not found
+ */
+//--------------------------------------------------------------------------------------------------
+static pa_mrc_ScanInformation_t** FindScanInformation
+(
+    ScanContext_t* contextPtr,
+    const char*    mccStr,
+    const char*    mncStr,
+    le_mrc_Rat_t   rat
+)
+{
+    uint32_t index = HashScanInformation(mccStr, mncStr, rat) & (SCAN_HASH_SIZE - 1);
+
+    while (contextPtr->table[index] != NULL)
+    {
+        pa_mrc_ScanInformation_t* nodePtr = contextPtr->table[index];
+
+        if (   (strcmp(nodePtr->mobileCode.mcc, mccStr) == 0)
+            && (strcmp(nodePtr->mobileCode.mnc, mncStr) == 0)
+            && (nodePtr->rat == rat)
+           )
+        {
+            LE_DEBUG("Found scan information for [%s,%s]", mccStr, mncStr);
+            break;
+        }
+
+        index = (index + 1) & (SCAN_HASH_SIZE - 1);
+    }
+
+    return &contextPtr->table[index];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a network scan context with the networks already in the list.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitializeScanContext
+(
+    ScanContext_t* contextPtr,
+    le_dls_List_t* scanInformationListPtr
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    memset(contextPtr, 0, sizeof(*contextPtr));
+    contextPtr->listPtr = scanInformationListPtr;
+
+    for (linkPtr = le_dls_Peek(scanInformationListPtr);
+         (linkPtr != NULL) && (contextPtr->count < HIGH_SCAN_INFO_COUNT);
+         linkPtr = le_dls_PeekNext(scanInformationListPtr, linkPtr))
+    {
+        pa_mrc_ScanInformation_t*  nodePtr = CONTAINER_OF(linkPtr, pa_mrc_ScanInformation_t, link);
+        pa_mrc_ScanInformation_t** entryPtr = FindScanInformation(contextPtr,
+                                                                  nodePtr->mobileCode.mcc,
+                                                                  nodePtr->mobileCode.mnc,
+                                                                  nodePtr->rat);
+        if (NULL == *entryPtr)
+        {
+            *entryPtr = nodePtr;
+            contextPtr->count++;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a network found by a scan, unless it is already known.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddScanInformation
+(
+    ScanContext_t* contextPtr,
+    const char*    mccStr,
+    const char*    mncStr,
+    le_mrc_Rat_t   rat,
+    uint32_t       networkStatus
+)
+{
+    pa_mrc_ScanInformation_t** entryPtr = FindScanInformation(contextPtr, mccStr, mncStr, rat);
+    pa_mrc_ScanInformation_t*  newScanInformation;
+
+    if (*entryPtr != NULL)
+    {
+        return;
+    }
+
+    if (contextPtr->count >= HIGH_SCAN_INFO_COUNT)
+    {
+        LE_WARN("Too many networks, [%s,%s] is dropped", mccStr, mncStr);
+        return;
+    }
+
+    newScanInformation = le_mem_TryAlloc(ScanInformationPool);
+    if (NULL == newScanInformation)
+    {
+        LE_WARN("No more scan information available");
+        return;
+    }
+
+    InitializeScanInformation(newScanInformation);
+    le_dls_Queue(contextPtr->listPtr, &(newScanInformation->link));
+    *entryPtr = newScanInformation;
+    contextPtr->count++;
+
+    le_utf8_Copy(newScanInformation->mobileCode.mcc, mccStr, LE_MRC_MCC_BYTES, NULL);
+    le_utf8_Copy(newScanInformation->mobileCode.mnc, mncStr, LE_MRC_MNC_BYTES, NULL);
+    newScanInformation->rat = rat;
+    /* 3GPP 27.007 Release 12 values definition
+     * <stat> : integer type
+     * 0    unknown
+     * 1    available
+     * 2    current
+     * 3    forbidden
+     */
+    switch(networkStatus)
+    {
+        default:
+        case 0:
+            break;
+        case 1:
+            newScanInformation->isAvailable = true;
+            break;
+        case 2:
+            newScanInformation->isInUse = true;
+            newScanInformation->isAvailable = true;
+            break;
+        case 3:
+            newScanInformation->isForbidden = true;
+            break;
+    }
+    LE_DEBUG("MCC %s, MNC %s, rat %d",
+        newScanInformation->mobileCode.mcc,
+        newScanInformation->mobileCode.mnc,
+        newScanInformation->rat);
+
+    if (ScanProgressHandler)
+    {
+        ScanProgressHandler(newScanInformation, contextPtr->count, ScanProgressContextPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a line of the AT+COPS=? response, network by network. A network truncated at the end of
+ * the line is ignored.
  *
- * @return
- *      - pointer on pa_mrc_ScanInformation_t
- *      - NULL if not found
+ * AT+COPS=?
+ * +COPS: (2,"RADIOLINJA","RL","24405",7),(0,"TELE","TELE","24491",7)
+ * +COPS: (2,"T-Mobile USA","TMO","310260"),,(0-4),(0-2)
  */
 //--------------------------------------------------------------------------------------------------
-static pa_mrc_ScanInformation_t* FindScanInformation
+static void ParseCopsLine
 (
-    le_dls_List_t *scanInformationListPtr,
-    char * mccStr,
-    char * mncStr,
-    le_mrc_Rat_t rat
+    ScanContext_t* contextPtr,
+    char*          lineStr
 )
 {
-    pa_mrc_ScanInformation_t* nodePtr;
-    le_dls_Link_t *linkPtr;
+    char         mncStr[LE_MRC_MNC_BYTES];
+    char         mccStr[LE_MRC_MCC_BYTES];
+    le_mrc_Rat_t rat;
+    uint32_t     networkStatus;
+    char*        ptr = lineStr;
+    char*        endPtr;
+    bool         isQuoted;
 
-    linkPtr = le_dls_Peek(scanInformationListPtr);
+    if (0 == strncmp(ptr, "+COPS:", strlen("+COPS:")))
+    {
+        ptr += strlen("+COPS:");
+    }
 
-    do
+    while (NULL != (ptr = strchr(ptr, '(')))
     {
-        if (linkPtr == NULL)
+        ptr++;
+        isQuoted = false;
+        for (endPtr = ptr; (*endPtr != NULL_CHAR) && (isQuoted || (*endPtr != ')')); endPtr++)
         {
-            break;
+            if ('"' == *endPtr)
+            {
+                isQuoted = !isQuoted;
+            }
         }
-        // Get the node from MsgList
-        nodePtr = CONTAINER_OF(linkPtr, pa_mrc_ScanInformation_t, link);
 
-        if (    (memcmp(nodePtr->mobileCode.mcc,mccStr,LE_MRC_MCC_BYTES)==0)
-             && (memcmp(nodePtr->mobileCode.mnc,mncStr,LE_MRC_MNC_BYTES)==0)
-             && (nodePtr->rat == rat)
-           )
+        if (NULL_CHAR == *endPtr)
         {
-            LE_DEBUG("Found scan information for [%s,%s]", mccStr, mncStr);
-            return nodePtr;
+            LE_WARN("Truncated network in +COPS response");
+            break;
         }
 
-        // Get Next element
-        linkPtr = le_dls_PeekNext(scanInformationListPtr,linkPtr);
-
-    } while (linkPtr != NULL);
+        // 2,"RADIOLINJA","RL","24405",7\0
+        *endPtr = NULL_CHAR;
+        if ((LE_OK == ExtractCopsPlmn(ptr, mccStr, mncStr, &rat, &networkStatus)) &&
+            (mccStr[0] != NULL_CHAR))
+        {
+            AddScanInformation(contextPtr, mccStr, mncStr, rat, networkStatus);
+        }
 
-    LE_DEBUG("Cannot find scan information for [%s,%s]",mccStr, mncStr);
-    return NULL;
+        // Skip [,,(list ofsupported<mode>s),(list of supported<format>s)]
+        ptr = endPtr + 1;
+        if (0 == strncmp(ptr, ",,", 2))
+        {
+            break;
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -705,6 +1943,22 @@ le_result_t pa_mrc_Init
                                             DEFAULT_PSSTATE_POOL_SIZE,
                                             sizeof(le_mrc_NetRegState_t));
 
+    RatChangeEventId = le_event_CreateIdWithRefCounting("RatChangeEventId");
+
+    RatChangePoolRef = le_mem_InitStaticPool(RatChangePool,
+                                             DEFAULT_RATCHANGE_POOL_SIZE,
+                                             sizeof(le_mrc_Rat_t));
+
+    SsIndEventId = le_event_CreateIdWithRefCounting("SsIndEventId");
+
+    SsIndPoolRef = le_mem_InitStaticPool(SsIndPool,
+                                         DEFAULT_SSIND_POOL_SIZE,
+                                         sizeof(pa_mrc_SignalStrengthIndication_t));
+
+    memset(SignalIndConfig, 0, sizeof(SignalIndConfig));
+    SignalSampleTimerRef = le_timer_Create("SignalSampleTimer");
+    le_timer_SetHandler(SignalSampleTimerRef, SignalSampleTimerHandler);
+
     ScanInformationPool=le_mem_InitStaticPool(ScanInformationPool,
                                               HIGH_SCAN_INFO_COUNT,
                                               sizeof(pa_mrc_ScanInformation_t));
@@ -714,6 +1968,7 @@ le_result_t pa_mrc_Init
                                          sizeof(pa_mrc_CellInfo_t));
 
     if(!NetworkRegEventId || !RegStatePoolRef || !PSStateEventId || !PSStatePoolRef
+       || !RatChangeEventId || !RatChangePoolRef || !SsIndEventId || !SsIndPoolRef
        || !ScanInformationPool || !CellInfoPool)
     {
         return LE_FAULT;
@@ -777,18 +2032,54 @@ le_result_t pa_mrc_PerformNetworkScan
     le_dls_List_t*      scanInformationListPtr ///< [OUT] list of pa_mrc_ScanInformation_t
 )
 {
-    le_result_t             res = LE_OK;
+    LE_UNUSED(ratMask);
+    LE_UNUSED(scanType);
+    le_result_t             res;
+    le_atClient_CmdRef_t    cmdRef = NULL;
+    ScanContext_t           context;
     char                    responseStr[LE_ATDEFS_RESPONSE_MAX_BYTES] = {0};
 
+    if (NULL == scanInformationListPtr)
+    {
+        return LE_FAULT;
+    }
+
     //at+cops=?
     //+COPS: (1,,,"00101",7),,(0-4),(0-2)
-    res = pa_utils_GetATIntermediateResponse("AT+COPS=?", "+COPS:", responseStr, sizeof(responseStr));
-    if (LE_OK == res)
+    // Some modems split the networks over several lines
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        "AT+COPS=?",
+                                        "+COPS:|(",
+                                        DEFAULT_AT_RESPONSE,
+                                        MAX_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
     {
-        res = pa_mrc_local_ParseNetworkScan(responseStr, ratMask, scanType, scanInformationListPtr);
+        LE_ERROR("Failed to send the command");
+        return res;
     }
 
-    return res;
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    if ((res != LE_OK) || (strcmp(responseStr, "OK") != 0))
+    {
+        LE_ERROR("Final response is not OK");
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
+
+    InitializeScanContext(&context, scanInformationListPtr);
+
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    while (LE_OK == res)
+    {
+        ParseCopsLine(&context, responseStr);
+        res = le_atClient_GetNextIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    }
+    le_atClient_Delete(cmdRef);
+
+    LE_DEBUG("%"PRIu32" networks found", context.count);
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -988,8 +2279,14 @@ le_event_HandlerRef_t pa_mrc_SetRatChangeHandler
     pa_mrc_RatChangeHdlrFunc_t handlerFuncPtr ///< [IN] The handler function.
 )
 {
-    LE_UNUSED(handlerFuncPtr);
-    return NULL;
+    if (handlerFuncPtr == NULL)
+    {
+        LE_FATAL("RAT change handler is NULL");
+    }
+
+    return (le_event_AddHandler("RatChangeHandler",
+                                RatChangeEventId,
+                                (le_event_HandlerFunc_t) handlerFuncPtr));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1005,8 +2302,7 @@ void pa_mrc_RemoveRatChangeHandler
     le_event_HandlerRef_t handlerRef
 )
 {
-    LE_UNUSED(handlerRef);
-    return;
+    le_event_RemoveHandler(handlerRef);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1090,8 +2386,6 @@ le_result_t pa_mrc_SetSignalStrengthIndDelta
     uint16_t     delta   ///< [IN] Signal delta in units of 0.1 dB
 )
 {
-    LE_UNUSED(delta);
-
     switch(rat)
     {
         case LE_MRC_RAT_GSM:
@@ -1107,6 +2401,10 @@ le_result_t pa_mrc_SetSignalStrengthIndDelta
             return LE_FAULT;
     }
 
+    SignalIndConfig[rat].delta = delta;
+    SignalIndConfig[rat].hasReference = false;
+    UpdateSignalMonitoring();
+
     return LE_OK;
 }
 //--------------------------------------------------------------------------------------------------
@@ -1141,9 +2439,22 @@ le_event_HandlerRef_t pa_mrc_AddSignalStrengthIndHandler
     void*                              contextPtr    ///< [IN] The context to be given to the handler.
 )
 {
-    LE_UNUSED(ssIndHandler);
-    LE_UNUSED(contextPtr);
-    return NULL;
+    le_event_HandlerRef_t handlerRef;
+
+    if (ssIndHandler == NULL)
+    {
+        LE_FATAL("Signal strength indication handler is NULL");
+    }
+
+    handlerRef = le_event_AddHandler("SignalStrengthIndHandler",
+                                     SsIndEventId,
+                                     (le_event_HandlerFunc_t) ssIndHandler);
+    le_event_SetContextPtr(handlerRef, contextPtr);
+
+    SsIndHandlerCount++;
+    UpdateSignalMonitoring();
+
+    return handlerRef;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1158,8 +2469,15 @@ void pa_mrc_RemoveSignalStrengthIndHandler
     le_event_HandlerRef_t handlerRef
 )
 {
-    LE_UNUSED(handlerRef);
-    return;
+    if ((NULL == handlerRef) || (0 == SsIndHandlerCount))
+    {
+        return;
+    }
+
+    le_event_RemoveHandler(handlerRef);
+
+    SsIndHandlerCount--;
+    UpdateSignalMonitoring();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1179,11 +2497,20 @@ le_result_t pa_mrc_SetSignalStrengthIndThresholds
     int32_t      upperRangeThreshold  ///< [IN] upper-range strength threshold in dBm
 )
 {
-    LE_UNUSED(rat);
-    LE_UNUSED(lowerRangeThreshold);
-    LE_UNUSED(upperRangeThreshold);
+    if ((rat <= LE_MRC_RAT_UNKNOWN) || (rat >= SIGNAL_IND_RAT_COUNT) ||
+        (lowerRangeThreshold >= upperRangeThreshold))
+    {
+        LE_ERROR("Bad parameter!");
+        return LE_FAULT;
+    }
 
-    return LE_FAULT;
+    SignalIndConfig[rat].hasThresholds = true;
+    SignalIndConfig[rat].lowerThreshold = lowerRangeThreshold;
+    SignalIndConfig[rat].upperThreshold = upperRangeThreshold;
+    SignalIndConfig[rat].hasReference = false;
+    UpdateSignalMonitoring();
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2059,6 +3386,15 @@ le_result_t pa_mrc_GetCurrentNetwork
     }
     else
     {
+        int nbParam = pa_utils_CountAndIsolateLineParameters(responseStr);
+
+        // Keep track of the <AcT> of the serving cell
+        if (nbParam >= COPS_PARAM_ACT_COUNT_ID)
+        {
+            UpdateAccessTechnology(ParseAct(pa_utils_IsolateLineParameter(responseStr,
+                                                                    COPS_PARAM_ACT_COUNT_ID)));
+        }
+
         if (nameStr != NULL)
         {
             // +COPS?
@@ -2067,7 +3403,6 @@ le_result_t pa_mrc_GetCurrentNetwork
             //  <format> indicates if the format is alphanumeric or numeric;
             // long alphanumeric format can be upto 16 characters long
             // responseStr = "+COPS: 0,0,\"Test Usim\",7"
-            int nbParam = pa_utils_CountAndIsolateLineParameters(responseStr);
             if(nbParam >= COPS_PARAM_OPERATOR_COUNT_ID)
             {
                 char * charPtr = pa_utils_IsolateLineParameter(responseStr,
@@ -2097,7 +3432,6 @@ le_result_t pa_mrc_GetCurrentNetwork
             // +COPS?
             // +COPS: <mode>[,<format>,<oper>[,<AcT>]]
             // responseStr = "+COPS: 0,2,\"00101\",7"
-            int nbParam = pa_utils_CountAndIsolateLineParameters(responseStr);
             if(nbParam >= COPS_PARAM_OPERATOR_COUNT_ID)
             {
                 char * charPtr = pa_utils_IsolateLineParameter(responseStr,
@@ -2174,10 +3508,21 @@ void pa_mrc_DeleteNeighborCellsInfo
 {
     pa_mrc_CellInfo_t* nodePtr;
     le_dls_Link_t *linkPtr;
+    int i;
 
     while ((linkPtr=le_dls_Pop(cellInfoListPtr)) != NULL)
     {
         nodePtr = CONTAINER_OF(linkPtr, pa_mrc_CellInfo_t, link);
+
+        // The kept neighbor cells can be updated in place again
+        for (i = 0; i < MAX_NEIGHBOR_CELLS; i++)
+        {
+            if (NeighborCells[i].cellInfoPtr == nodePtr)
+            {
+                NeighborCells[i].isLent = false;
+            }
+        }
+
         le_mem_Release(nodePtr);
     }
 }
@@ -2440,11 +3785,7 @@ le_result_t pa_mrc_local_ParseNetworkScan
 {
     LE_UNUSED(ratMask);
     LE_UNUSED(scanType);
-    le_result_t             res = LE_OK;
-    int                     nbNetwork;
-    char                    mncStr[LE_MRC_MNC_BYTES];
-    char                    mccStr[LE_MRC_MCC_BYTES];
-    char *                  charPtr = NULL;
+    ScanContext_t           context;
     /* AT+COPS=? 3GPP 27.007 Release 12 response:
      * +COPS: [list of supported(<stat>,long alphanumeric<oper>,
      *          shortalphanumeric<oper>,numeric<oper>[,<AcT>])s]
@@ -2455,95 +3796,15 @@ le_result_t pa_mrc_local_ParseNetworkScan
      * +COPS: (1,,,"00101",7),,(0-4),(0-2)
      * OK
      */
-    if(NULL == responseStr)
+    if((NULL == responseStr) || (NULL == scanInformationListPtr))
     {
         return LE_FAULT;
     }
 
-    // Remove  [,,(list ofsupported<mode>s),(list of supported<format>s)] If present
-    // +COPS: (2,"T-Mobile USA","TMO","310260"),,(0-4),(0-2)
-    charPtr = strstr(responseStr, ",,(");
-    if(charPtr)
-    {
-        // +COPS: (2,"T-Mobile USA","TMO","310260")\0
-        *charPtr = NULL_CHAR;
-    }
-
-    // +COPS: (2,"RADIOLINJA","RL","24405",7),(0,"TELE","TELE","24491",7)
-    nbNetwork = pa_utils_CountAndIsolateCopsParameters(responseStr);
-    // +COPS: \02,"RADIOLINJA","RL","24405",7\0,\00,"TELE","TELE","24491",7\0
-
-    if ( (LE_OK == res) && nbNetwork )
-    {
-        pa_mrc_ScanInformation_t* newScanInformation = NULL;
-        int i;
-        le_mrc_Rat_t rat;
-        uint32_t networkStatus;
-
-        for (i=1; i<=nbNetwork; i++)
-        {
-            // 2,"RADIOLINJA","RL","24405",7\0
-            // 0,"TELE","TELE","24491",7\0
-            // +COPS: \02,\"RADIOLINJA\",\"RL\",\"24405\",7\0,\00,\"TELE\",\"TELE\",\"24491\",7\0"
-            char * plmnPtr = pa_utils_IsolateLineParameter(responseStr, i * 2);
-
-            // Extract fields
-            // 2,"RADIOLINJA","RL","24405",7\0
-            // 0,"TELE","TELE","24491",7\0
-            res = ExtractCopsPlmn(plmnPtr, mccStr, mncStr, &rat, &networkStatus);
+    InitializeScanContext(&context, scanInformationListPtr);
+    ParseCopsLine(&context, responseStr);
 
-            newScanInformation = FindScanInformation(scanInformationListPtr, mccStr, mncStr, rat);
-            if (newScanInformation == NULL)
-            {
-                newScanInformation = le_mem_ForceAlloc(ScanInformationPool);
-                InitializeScanInformation(newScanInformation);
-                le_dls_Queue(scanInformationListPtr,&(newScanInformation->link));
-
-                memcpy(newScanInformation->mobileCode.mcc, mccStr, LE_MRC_MCC_BYTES);
-                memcpy(newScanInformation->mobileCode.mnc, mncStr, LE_MRC_MNC_BYTES);
-                newScanInformation->rat = rat;
-                /* 3GPP 27.007 Release 12 values definition
-                 * <stat> : integer type
-                 * 0    unknown
-                 * 1    available
-                 * 2    current
-                 * 3    forbidden
-                 */
-
-                //     bool  isInUse;        ///< network is in use
-                //     bool  isAvailable;    ///< network can be connected
-                //     bool  isHome;         ///< home status
-                //     bool  isForbidden;    ///< forbidden status
-                switch(networkStatus)
-                {
-                    default:
-                    case 0:
-                        break;
-                    case 1:
-                    {
-                        newScanInformation->isAvailable = true;
-                    }
-                    break;
-                    case 2:
-                    {
-                        newScanInformation->isInUse = true;
-                        newScanInformation->isAvailable = true;
-                    }
-                    break;
-                    case 3:
-                    {
-                        newScanInformation->isForbidden = true;
-                    }
-                    break;
-                }
-                LE_DEBUG("MCC %s, MNS %s, rat %d",
-                    newScanInformation->mobileCode.mcc,
-                    newScanInformation->mobileCode.mnc,
-                    newScanInformation->rat);
-            }
-        }
-    }
-    return res;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2589,3 +3850,212 @@ le_result_t pa_mrc_local_GetOperatorTextMode
 
     return res;
 }
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function invalidates the registration state cached from the unsolicited reports, e.g. after
+ * a SIM refresh. It is read again from the modem on its next access.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_mrc_local_InvalidateRegistrationState
+(
+    void
+)
+{
+    CurrentAct = ACT_UNKNOWN;
+    PSState = LE_MRC_REG_UNKNOWN;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the <AcT> of the serving cell, as last reported by +CREG / +CEREG / +COPS.
+ * The modem is only queried with AT+COPS? when no <AcT> is known yet.
+ *
+ * @return LE_BAD_PARAMETER The parameter is invalid.
+ * @return LE_UNAVAILABLE   The access technology is not known.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mrc_local_GetCurrentAct
+(
+    int* actPtr                 ///< [OUT] The <AcT> of the serving cell (3GPP 27.007).
+)
+{
+    if (!actPtr)
+    {
+        LE_ERROR("actPtr is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    if (ACT_UNKNOWN == CurrentAct)
+    {
+        ReadCurrentAct();
+    }
+
+    if (ACT_UNKNOWN == CurrentAct)
+    {
+        return LE_UNAVAILABLE;
+    }
+
+    *actPtr = CurrentAct;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the Radio Access Technology of the serving cell, as last reported by +CREG /
+ * +CEREG / +COPS.
+ *
+ * @return LE_BAD_PARAMETER The parameter is invalid.
+ * @return LE_UNAVAILABLE   The Radio Access Technology is not known.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_mrc_local_GetCurrentRat
+(
+    le_mrc_Rat_t* ratPtr        ///< [OUT] The Radio Access Technology.
+)
+{
+    int         act;
+    le_result_t res;
+
+    if (!ratPtr)
+    {
+        LE_ERROR("ratPtr is NULL");
+        return LE_BAD_PARAMETER;
+    }
+
+    res = pa_mrc_local_GetCurrentAct(&act);
+    if (LE_OK != res)
+    {
+        return res;
+    }
+
+    *ratPtr = CurrentRat;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the cell monitoring command used to collect the neighbor cells.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_mrc_local_SetCellMonitorProfile
+(
+    pa_mrc_CellMonitorProfile_t profile     ///< [IN] The cell monitoring command.
+)
+{
+    if ((profile < PA_MRC_CELL_MONITOR_NONE) || (profile >= NUM_ARRAY_MEMBERS(CellMonitorCommands)))
+    {
+        LE_ERROR("Bad cell monitoring command %d", profile);
+        return;
+    }
+
+    CellMonitorProfile = profile;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function retrieves the Neighboring Cells information with the cell monitoring command.
+ * Each cell information is queued in the list specified with the IN/OUT parameter, and must be
+ * released with pa_mrc_DeleteNeighborCellsInfo().
+ *
+ * @return LE_FAULT          The function failed to retrieve the Neighboring Cells information.
+ * @return a positive value  The function succeeded. The number of cells which the information have
+ *                           been retrieved.
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t pa_mrc_local_GetNeighborCellsInfo
+(
+    le_dls_List_t* cellInfoListPtr  ///< [OUT] The Neighboring Cells information.
+)
+{
+    const CellMonitorCommand_t* commandPtr = &CellMonitorCommands[CellMonitorProfile];
+    le_atClient_CmdRef_t        cmdRef     = NULL;
+    le_result_t                 res;
+    ParsedCell_t                cells[MAX_NEIGHBOR_CELLS];
+    char                        responseStr[LE_ATDEFS_RESPONSE_MAX_BYTES] = {0};
+    int                         count      = 0;
+    int                         i;
+
+    if (!cellInfoListPtr)
+    {
+        LE_ERROR("cellInfoListPtr is NULL");
+        return LE_FAULT;
+    }
+
+    if (NULL == commandPtr->commandStr)
+    {
+        LE_DEBUG("No cell monitoring command");
+        return LE_FAULT;
+    }
+
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        commandPtr->commandStr,
+                                        commandPtr->interStr,
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (res != LE_OK)
+    {
+        LE_ERROR("Failed to send the command");
+        return LE_FAULT;
+    }
+
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    if ((res != LE_OK) || (strcmp(responseStr, "OK") != 0))
+    {
+        LE_ERROR("Final response is not OK");
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
+
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    while ((LE_OK == res) && (count < MAX_NEIGHBOR_CELLS))
+    {
+        count += commandPtr->lineParser(responseStr, &cells[count], MAX_NEIGHBOR_CELLS - count);
+        res = le_atClient_GetNextIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    }
+    le_atClient_Delete(cmdRef);
+
+    RefreshNeighborCells(cells, count);
+
+    count = 0;
+    for (i = 0; i < MAX_NEIGHBOR_CELLS; i++)
+    {
+        pa_mrc_CellInfo_t* cellInfoPtr = NeighborCells[i].cellInfoPtr;
+
+        if ((NULL == cellInfoPtr) || (NeighborCells[i].isLent))
+        {
+            continue;
+        }
+
+        // The caller list holds its own reference on the cell information
+        le_mem_AddRef(cellInfoPtr);
+        cellInfoPtr->index = count++;
+        cellInfoPtr->link = LE_DLS_LINK_INIT;
+        le_dls_Queue(cellInfoListPtr, &cellInfoPtr->link);
+        NeighborCells[i].isLent = true;
+    }
+
+    LE_DEBUG("%d neighbor cells", count);
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the handler called for each new network found by a network scan.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_mrc_local_SetScanProgressHandler
+(
+    pa_mrc_ScanProgressHandlerFunc_t handlerFunc,   ///< [IN] The handler, NULL to remove it.
+    void*                            contextPtr     ///< [IN] The handler context.
+)
+{
+    ScanProgressHandler = handlerFunc;
+    ScanProgressContextPtr = contextPtr;
+}
@@ -28,6 +28,7 @@
 #define COPS_PARAM_MODE_COUNT_ID        2
 #define COPS_PARAM_FORMAT_COUNT_ID      3
 #define COPS_PARAM_OPERATOR_COUNT_ID    4
+#define COPS_PARAM_ACT_COUNT_ID         5
 
 
 //--------------------------------------------------------------------------------------------------
@@ -38,6 +39,8 @@
  * +CREG:  <n>,<stat>[,[<lac>],[<ci>],[<AcT>]
  * +CEREG?
  * +CEREG: <n>,<stat>[,<tac>,<ci>[,<AcT>]]
+ * +CREG: / +CEREG: unsolicited
+ * +CEREG: <stat>[,<tac>,<ci>[,<AcT>]]
  *  <n>: integer type
  *  0    disable network registration unsolicited result code
  *  1    enable network registration unsolicited result code +CREG: <stat>
@@ -48,8 +51,29 @@
 #define REG_PARAM_MODE_UNSO            1
 #define REG_PARAM_MODE_VERBOSE         2
 #define REG_PARAM_POS_ACT_COUNT_ID     6
+#define REG_UNSO_PARAM_POS_ACT_COUNT_ID 5
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Define value for +CESQ string management
+ *
+ * +CESQ: <rxlev>,<ber>,<rscp>,<ecno>,<rsrq>,<rsrp>
+ *  <rxlev>: 0..63, 99 not known (GSM)
+ *  <ber>:   0..7, 99 not known (GSM)
+ *  <rscp>:  0..96, 255 not known (UTRAN)
+ *  <ecno>:  0..49, 255 not known (UTRAN)
+ *  <rsrq>:  0..34, 255 not known (E-UTRAN)
+ *  <rsrp>:  0..97, 255 not known (E-UTRAN)
+ */
+//--------------------------------------------------------------------------------------------------
+#define CESQ_PARAM_RXLEV_COUNT_ID       2
+#define CESQ_PARAM_BER_COUNT_ID         3
+#define CESQ_PARAM_RSCP_COUNT_ID        4
+#define CESQ_PARAM_ECNO_COUNT_ID        5
+#define CESQ_PARAM_RSRQ_COUNT_ID        6
+#define CESQ_PARAM_RSRP_COUNT_ID        7
+
 //--------------------------------------------------------------------------------------------------
 /**
  * 3GPP 27.007 release 12 <format> definition
@@ -88,6 +112,33 @@ typedef enum
 }
 pa_mrc_RegistrationType_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cell monitoring command used to collect the neighbor cells
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PA_MRC_CELL_MONITOR_NONE,   ///< Neighbor cells are not collected.
+    PA_MRC_CELL_MONITOR_CCED,   ///< AT+CCED cell environment (GSM neighbor cells).
+    PA_MRC_CELL_MONITOR_QENG    ///< AT+QENG="neighbourcell" engineering mode (GSM/UMTS/LTE).
+}
+pa_mrc_CellMonitorProfile_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called for each new network found by a network scan, before the scan is complete.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*pa_mrc_ScanProgressHandlerFunc_t)
+(
+    pa_mrc_ScanInformation_t* scanInformationPtr,   ///< [IN] The network found.
+    uint32_t                  count,                ///< [IN] Number of networks found so far.
+    void*                     contextPtr            ///< [IN] The handler context.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to initialize the mrc module
@@ -243,4 +294,84 @@ LE_SHARED le_result_t pa_mrc_local_ConvertActToRat
     le_mrc_Rat_t*   ratPtr      ///< [OUT] The Radio Access Technology.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the <AcT> of the serving cell, as last reported by +CREG / +CEREG / +COPS.
+ * The modem is only queried with AT+COPS? when no <AcT> is known yet.
+ *
+ * @return LE_BAD_PARAMETER The parameter is invalid.
+ * @return LE_UNAVAILABLE   The access technology is not known.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t pa_mrc_local_GetCurrentAct
+(
+    int* actPtr                 ///< [OUT] The <AcT> of the serving cell (3GPP 27.007).
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function gets the Radio Access Technology of the serving cell, as last reported by +CREG /
+ * +CEREG / +COPS.
+ *
+ * @return LE_BAD_PARAMETER The parameter is invalid.
+ * @return LE_UNAVAILABLE   The Radio Access Technology is not known.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t pa_mrc_local_GetCurrentRat
+(
+    le_mrc_Rat_t* ratPtr        ///< [OUT] The Radio Access Technology.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the cell monitoring command used to collect the neighbor cells.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void pa_mrc_local_SetCellMonitorProfile
+(
+    pa_mrc_CellMonitorProfile_t profile     ///< [IN] The cell monitoring command.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function retrieves the Neighboring Cells information with the cell monitoring command.
+ * Each cell information is queued in the list specified with the IN/OUT parameter, and must be
+ * released with pa_mrc_DeleteNeighborCellsInfo().
+ *
+ * @return LE_FAULT          The function failed to retrieve the Neighboring Cells information.
+ * @return a positive value  The function succeeded. The number of cells which the information have
+ *                           been retrieved.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int32_t pa_mrc_local_GetNeighborCellsInfo
+(
+    le_dls_List_t* cellInfoListPtr  ///< [OUT] The Neighboring Cells information.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function sets the handler called for each new network found by a network scan.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void pa_mrc_local_SetScanProgressHandler
+(
+    pa_mrc_ScanProgressHandlerFunc_t handlerFunc,   ///< [IN] The handler, NULL to remove it.
+    void*                            contextPtr     ///< [IN] The handler context.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function invalidates the registration state cached from the unsolicited reports, e.g. after
+ * a SIM refresh. It is read again from the modem on its next access.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void pa_mrc_local_InvalidateRegistrationState
+(
+    void
+);
+
 #endif // LEGATO_PAMRCLOCAL_INCLUDE_GUARD
@@ -17,14 +17,262 @@
 #endif
 
 #include "pa_utils.h"
+#include "pa_sim_local.h"
 #include "pa_sim_utils_local.h"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffer size to read a SIM elementary file or record
+ */
+//--------------------------------------------------------------------------------------------------
+#define EF_RECORD_MAX_BYTES         128
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * EF MSISDN record size without the alpha identifier
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSISDN_RECORD_MIN_BYTES     14
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum BCD length of an EF MSISDN number, TON/NPI included
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSISDN_BCD_MAX_BYTES        11
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a PLMN in the SIM elementary files
+ */
+//--------------------------------------------------------------------------------------------------
+#define PLMN_BYTES                  3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * +CPINR code names, indexed by the remaining attempts table index
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const CpinrCodes[] =
+{
+    "SIM PIN",
+    "SIM PIN2",
+    "SIM PUK",
+    "SIM PUK2",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remaining attempts of the PIN and PUK codes, indexed as CpinrCodes
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RemainingAttempts[NUM_ARRAY_MEMBERS(CpinrCodes)];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether each RemainingAttempts entry was reported by the modem
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RemainingAttemptsKnown[NUM_ARRAY_MEMBERS(CpinrCodes)];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether the remaining attempts table is up to date
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RemainingAttemptsValid = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a PLMN stored in a SIM elementary file (3GPP TS 24.008 encoding).
+ */
+//--------------------------------------------------------------------------------------------------
+static void DecodePlmn
+(
+    const uint8_t* plmnPtr,     ///< [IN] PLMN, 3 bytes
+    char*          mccStr,      ///< [OUT] Mobile Country Code, LE_MRC_MCC_BYTES
+    char*          mncStr       ///< [OUT] Mobile Network Code, LE_MRC_MNC_BYTES
+)
+{
+    mccStr[0] = '0' + (plmnPtr[0] & 0x0F);
+    mccStr[1] = '0' + (plmnPtr[0] >> 4);
+    mccStr[2] = '0' + (plmnPtr[1] & 0x0F);
+    mccStr[3] = NULL_CHAR;
+
+    mncStr[0] = '0' + (plmnPtr[2] & 0x0F);
+    mncStr[1] = '0' + (plmnPtr[2] >> 4);
+    mncStr[2] = ((plmnPtr[1] >> 4) == 0x0F) ? NULL_CHAR : '0' + (plmnPtr[1] >> 4);
+    mncStr[3] = NULL_CHAR;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a string is made of a given range of decimal digits.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsDigitString
+(
+    const char* strPtr,     ///< [IN] String to check
+    size_t      minLen,     ///< [IN] Minimum number of digits
+    size_t      maxLen      ///< [IN] Maximum number of digits
+)
+{
+    size_t len;
+
+    for (len = 0; strPtr[len] != NULL_CHAR; len++)
+    {
+        if ((len >= maxLen) || (!isdigit((unsigned char)strPtr[len])))
+        {
+            return false;
+        }
+    }
+
+    return (len >= minLen);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode a PLMN for a SIM elementary file (3GPP TS 24.008 encoding).
+ *
+ * @return LE_BAD_PARAMETER The MCC is not 3 digits or the MNC is not 2 or 3 digits.
+ * @return LE_OK            The PLMN is encoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t EncodePlmn
+(
+    const char* mccStr,     ///< [IN] Mobile Country Code
+    const char* mncStr,     ///< [IN] Mobile Network Code, 2 or 3 digits
+    uint8_t*    plmnPtr     ///< [OUT] PLMN, 3 bytes
+)
+{
+    uint8_t mnc3;
+
+    if ((!IsDigitString(mccStr, 3, 3)) || (!IsDigitString(mncStr, 2, 3)))
+    {
+        LE_ERROR("Invalid PLMN %s-%s", mccStr, mncStr);
+        return LE_BAD_PARAMETER;
+    }
+
+    mnc3 = (strlen(mncStr) > 2) ? (mncStr[2] - '0') : 0x0F;
+
+    plmnPtr[0] = ((mccStr[1] - '0') << 4) | (mccStr[0] - '0');
+    plmnPtr[1] = (mnc3 << 4) | (mccStr[2] - '0');
+    plmnPtr[2] = ((mncStr[1] - '0') << 4) | (mncStr[0] - '0');
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a +CPINR intermediate response into the remaining attempts table.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseCpinrLine
+(
+    char* lineStr   ///< [IN] +CPINR: <code>,<retries>[,<default_retries>]
+)
+{
+    char*    codePtr;
+    uint32_t i;
 
+    if (pa_utils_CountAndIsolateLineParameters(lineStr) < 3)
+    {
+        return;
+    }
+
+    codePtr = pa_utils_IsolateLineParameter(lineStr, 2);
+    pa_utils_RemoveQuotationString(codePtr);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(CpinrCodes); i++)
+    {
+        if (0 == strcmp(codePtr, CpinrCodes[i]))
+        {
+            RemainingAttempts[i] = atoi(pa_utils_IsolateLineParameter(lineStr, 3));
+            RemainingAttemptsKnown[i] = true;
+            return;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the remaining attempts of all PIN and PUK codes with AT+CPINR.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadRemainingAttempts
+(
+    void
+)
+{
+    le_atClient_CmdRef_t cmdRef = NULL;
+    le_result_t          res;
+    char                 responseStr[PA_AT_LOCAL_STRING_SIZE] = {0};
+
+    RemainingAttemptsValid = false;
+    memset(RemainingAttemptsKnown, 0, sizeof(RemainingAttemptsKnown));
+
+    res = le_atClient_SetCommandAndSend(&cmdRef,
+                                        pa_utils_GetAtDeviceRef(),
+                                        "AT+CPINR",
+                                        "+CPINR:",
+                                        DEFAULT_AT_RESPONSE,
+                                        DEFAULT_AT_CMD_TIMEOUT);
+    if (LE_OK != res)
+    {
+        LE_ERROR("Failed to send the command");
+        return LE_FAULT;
+    }
+
+    res = le_atClient_GetFinalResponse(cmdRef, responseStr, sizeof(responseStr));
+    if ((LE_OK != res) || (strcmp(responseStr, "OK") != 0))
+    {
+        LE_ERROR("Failed to get the response");
+        le_atClient_Delete(cmdRef);
+        return LE_FAULT;
+    }
+
+    res = le_atClient_GetFirstIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    while (LE_OK == res)
+    {
+        ParseCpinrLine(responseStr);
+        res = le_atClient_GetNextIntermediateResponse(cmdRef, responseStr, sizeof(responseStr));
+    }
+    le_atClient_Delete(cmdRef);
+
+    RemainingAttemptsValid = true;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a PIN or PUK related command and refresh the remaining attempts table, whatever its
+ * outcome.
+ *
+ * @return LE_FAULT         The function failed.
+ * @return LE_OK            The function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendPinCommand
+(
+    const char* commandPtr  ///< [IN] AT command
+)
+{
+    le_result_t res = pa_utils_SendATCommandOK(commandPtr);
+
+    pa_sim_local_RefreshRemainingAttempts();
+    return res;
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
  * This function get the remaining attempts of a code.
  *
+ * The counters are served from the table read with AT+CPINR, which is only read again after a
+ * PIN or PUK operation or a SIM state change.
+ *
  * @return LE_BAD_PARAMETER The parameters are invalid.
  * @return LE_FAULT         The function failed.
  * @return LE_TIMEOUT       No response was received.
@@ -37,16 +285,61 @@ static le_result_t pa_sim_GetRemainingAttempts
     uint32_t* attemptsPtr  ///< [OUT] The number of attempts still possible
 )
 {
-    LE_UNUSED(idx);
-    LE_UNUSED(attemptsPtr);
+    if ((idx >= NUM_ARRAY_MEMBERS(CpinrCodes)) || (!attemptsPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
 
-    return LE_FAULT;
+    if ((!RemainingAttemptsValid) && (LE_OK != ReadRemainingAttempts()))
+    {
+        return LE_FAULT;
+    }
+
+    if (!RemainingAttemptsKnown[idx])
+    {
+        LE_WARN("%s remaining attempts not reported", CpinrCodes[idx]);
+        return LE_FAULT;
+    }
+
+    *attemptsPtr = RemainingAttempts[idx];
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read again the PIN and PUK remaining attempts table.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_RefreshRemainingAttempts
+(
+    void
+)
+{
+    if (LE_OK != ReadRemainingAttempts())
+    {
+        LE_WARN("Failed to refresh the remaining attempts");
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the PIN and PUK remaining attempts table, it is read again on its next access.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_InvalidateRemainingAttempts
+(
+    void
+)
+{
+    RemainingAttemptsValid = false;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the SIM Phone Number.
  *
+ * The number is read from the first record of EF MSISDN.
+ *
  * @return
  *      - LE_OK on success
  *      - LE_OVERFLOW if the Phone Number can't fit in phoneNumberStr
@@ -59,12 +352,11 @@ le_result_t pa_sim_GetSubscriberPhoneNumber
     size_t       phoneNumberStrSize ///< [IN]  Size of phoneNumberStr
 )
 {
-    le_atClient_CmdRef_t cmdRef = NULL;
-    le_result_t          res    = LE_OK;
-    char                *tokenPtr = NULL;
-    char                 responseStr[PA_AT_LOCAL_SHORT_SIZE] = {0};
-    int32_t              cmeeMode = pa_utils_GetCmeeMode();
-    uint8_t              paramNum;
+    uint8_t     record[EF_RECORD_MAX_BYTES];
+    size_t      len = sizeof(record);
+    size_t      offset;
+    uint8_t     bcdLen;
+    le_result_t res;
 
     if (!phoneNumberStr || !phoneNumberStrSize)
     {
@@ -72,67 +364,43 @@ le_result_t pa_sim_GetSubscriberPhoneNumber
         return LE_FAULT;
     }
 
-    pa_utils_SetCmeeMode(1);
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-        pa_utils_GetAtDeviceRef(),
-        "AT+CNUM",
-        "+CNUM:",
-        DEFAULT_AT_RESPONSE,
-        DEFAULT_AT_CMD_TIMEOUT);
+    phoneNumberStr[0] = NULL_CHAR;
 
-    if (res != LE_OK)
+    res = pa_sim_local_ReadEf(PA_SIM_EF_MSISDN, record, &len);
+    if (LE_NOT_FOUND == res)
     {
-        LE_ERROR("Failed to send the command");
-        pa_utils_SetCmeeMode(cmeeMode);
-        return LE_FAULT;
+        LE_WARN("No MSIDN Provided");
+        return LE_OK;
     }
-
-    res = le_atClient_GetFinalResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_SHORT_SIZE);
-
-    if (res != LE_OK || (strcmp(responseStr,"OK") != 0))
+    else if ((LE_OK != res) || (len < MSISDN_RECORD_MIN_BYTES))
     {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
-        pa_utils_SetCmeeMode(cmeeMode);
+        LE_ERROR("Failed to read EF MSISDN");
         return LE_FAULT;
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_SHORT_SIZE);
-
-    le_atClient_Delete(cmdRef);
-    pa_utils_SetCmeeMode(cmeeMode);
-    phoneNumberStr[0] = NULL_CHAR;
-
-    if (res != LE_OK)
+    // Alpha identifier, then BCD length (TON/NPI included), TON/NPI and dialling number
+    offset = len - MSISDN_RECORD_MIN_BYTES;
+    bcdLen = record[offset];
+    if ((0xFF == bcdLen) || (bcdLen < 2) || (bcdLen > MSISDN_BCD_MAX_BYTES))
     {
         LE_WARN("No MSIDN Provided");
         return LE_OK;
     }
 
-    paramNum = pa_utils_CountAndIsolateLineParameters(responseStr);
-    if(paramNum != 4)
+    // International number
+    if (0x10 == (record[offset + 1] & 0x70))
     {
-        LE_WARN("No MSIDN Provided");
-        return LE_OK;
-    }
-    // Extract the phone number string
-    tokenPtr = pa_utils_IsolateLineParameter(responseStr, 3);
-    if(!tokenPtr)
-    {
-        LE_WARN("No MSIDN Provided");
-        return LE_OK;
+        if (phoneNumberStrSize < 2)
+        {
+            return LE_OVERFLOW;
+        }
+        phoneNumberStr[0] = '+';
+        phoneNumberStr++;
+        phoneNumberStrSize--;
     }
 
-    // Remove the quotation marks
-    pa_utils_RemoveQuotationString(tokenPtr);
-
-    res = le_utf8_Copy(phoneNumberStr, tokenPtr, phoneNumberStrSize, NULL);
-
-    return res;
+    return pa_sim_utils_DecodeBcd(&record[offset + 2], bcdLen - 1,
+                                  phoneNumberStr, phoneNumberStrSize);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -234,7 +502,6 @@ le_result_t pa_sim_ChangePIN
 )
 {
     char                 command[PA_AT_LOCAL_SHORT_SIZE];
-    le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_OK;
 
     if (type==PA_SIM_PIN)
@@ -250,20 +517,7 @@ le_result_t pa_sim_ChangePIN
         return LE_BAD_PARAMETER;
     }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        command,
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    le_atClient_Delete(cmdRef);
+    res = SendPinCommand(command);
     return res;
 }
 
@@ -285,7 +539,6 @@ le_result_t pa_sim_EnablePIN
 )
 {
     char                 command[PA_AT_LOCAL_SHORT_SIZE];
-    le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_OK;
 
     if (type==PA_SIM_PIN)
@@ -301,20 +554,7 @@ le_result_t pa_sim_EnablePIN
         return LE_BAD_PARAMETER;
     }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        command,
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    le_atClient_Delete(cmdRef);
+    res = SendPinCommand(command);
     return res;
 }
 
@@ -336,7 +576,6 @@ le_result_t pa_sim_DisablePIN
 )
 {
     char                 command[LE_ATDEFS_COMMAND_MAX_BYTES];
-    le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_OK;
 
     if      (type==PA_SIM_PIN)
@@ -352,20 +591,7 @@ le_result_t pa_sim_DisablePIN
         return LE_BAD_PARAMETER;
     }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        command,
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    le_atClient_Delete(cmdRef);
+    res = SendPinCommand(command);
     return res;
 }
 
@@ -373,6 +599,8 @@ le_result_t pa_sim_DisablePIN
 /**
  * This function must be called to get the Home Network Name information.
  *
+ * The name is the service provider name read from EF SPN.
+ *
  * @return
  *      - LE_OK on success
  *      - LE_OVERFLOW if the Home Network Name can't fit in nameStr
@@ -385,11 +613,11 @@ le_result_t pa_sim_GetHomeNetworkOperator
     size_t      nameStrSize            ///< [IN] the nameStr size
 )
 {
-    le_result_t          res      = LE_OK;
-    le_atClient_CmdRef_t cmdRef   = NULL;
-    char*                tokenPtr = NULL;
-    char*                savePtr  = NULL;
-    char                 responseStr[PA_AT_LOCAL_STRING_SIZE];
+    uint8_t     spn[EF_RECORD_MAX_BYTES];
+    size_t      len = sizeof(spn);
+    size_t      nameLen = 0;
+    size_t      i;
+    le_result_t res;
 
     if (!nameStr)
     {
@@ -397,54 +625,32 @@ le_result_t pa_sim_GetHomeNetworkOperator
         return LE_BAD_PARAMETER;
     }
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        "AT+COPS?",
-                                        "+COPS:",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return LE_FAULT;
-    }
-
-    res = le_atClient_GetFinalResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
-
-    if ((res != LE_OK) || (strcmp(responseStr,"OK") != 0))
+    res = pa_sim_local_ReadEf(PA_SIM_EF_SPN, spn, &len);
+    if ((LE_OK != res) || (len < 2))
     {
-        LE_ERROR("Failed to get the response");
-        le_atClient_Delete(cmdRef);
+        LE_ERROR("Failed to read EF SPN");
         return LE_FAULT;
     }
 
-    res = le_atClient_GetFirstIntermediateResponse(cmdRef,
-        responseStr,
-        PA_AT_LOCAL_STRING_SIZE);
-    le_atClient_Delete(cmdRef);
-
-    if (res != LE_OK)
+    // Display condition, then the name in the GSM default alphabet padded with 0xFF. UCS2 coded
+    // names are not supported.
+    if (spn[1] >= 0x80)
     {
-        LE_ERROR("Failed to get the response");
+        LE_ERROR("Unsupported SPN coding");
         return LE_FAULT;
     }
 
-    // Cut the string for keep just the Home PLMN
-    res = LE_FAULT;
-    tokenPtr = strtok_r(responseStr, "\"", &savePtr);
-    if(tokenPtr)
+    for (i = 1; (i < len) && (0xFF != spn[i]); i++)
     {
-        tokenPtr = strtok_r(NULL, "\"", &savePtr);
-        if(tokenPtr)
+        if ((nameLen + 1) >= nameStrSize)
         {
-            res = le_utf8_Copy(nameStr, tokenPtr, nameStrSize, NULL);
+            return LE_OVERFLOW;
         }
+        nameStr[nameLen++] = (char) spn[i];
     }
+    nameStr[nameLen] = NULL_CHAR;
 
-    return res;
+    return (nameLen > 0) ? LE_OK : LE_FAULT;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -516,24 +722,6 @@ le_result_t pa_sim_Refresh
     return LE_FAULT;
 }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * This function must be called to confirm a SIM Toolkit command.
- *
- * @return
- *      - LE_OK on success
- *      - LE_FAULT on failure
- */
-//--------------------------------------------------------------------------------------------------
-le_result_t pa_sim_ConfirmSimToolkitCommand
-(
-    bool  confirmation  ///< [IN] true to accept, false to reject
-)
-{
-    LE_UNUSED(confirmation);
-    return LE_FAULT;
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to reset the SIM.
@@ -563,13 +751,66 @@ le_result_t pa_sim_Reset
  *      - LE_UNSUPPORTED    The platform does not support this operation.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_WriteFPLMNList
+le_result_t pa_sim_WriteFPLMNList
 (
     le_dls_List_t *FPLMNListPtr ///< [IN] List of FPLMN operators
 )
 {
-    LE_UNUSED(FPLMNListPtr);
-    return LE_UNSUPPORTED;
+    uint8_t        data[EF_RECORD_MAX_BYTES];
+    size_t         len = sizeof(data);
+    size_t         offset = 0;
+    uint8_t        sw1 = 0;
+    uint8_t        sw2 = 0;
+    uint8_t        resp[1];
+    size_t         respLen = sizeof(resp);
+    le_dls_Link_t* linkPtr;
+    le_result_t    res;
+
+    if (!FPLMNListPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    // The file size is fixed by the card
+    res = pa_sim_local_ReadEf(PA_SIM_EF_FPLMN, data, &len);
+    if (LE_OK != res)
+    {
+        LE_ERROR("Failed to read EF FPLMN");
+        return LE_FAULT;
+    }
+
+    memset(data, 0xFF, len);
+    for (linkPtr = le_dls_Peek(FPLMNListPtr);
+         linkPtr;
+         linkPtr = le_dls_PeekNext(FPLMNListPtr, linkPtr))
+    {
+        pa_sim_FPLMNOperator_t* operatorPtr = CONTAINER_OF(linkPtr, pa_sim_FPLMNOperator_t, link);
+
+        if ((offset + PLMN_BYTES) > len)
+        {
+            LE_ERROR("EF FPLMN is full");
+            return LE_FAULT;
+        }
+
+        if (LE_OK != EncodePlmn(operatorPtr->mobileCountryCode, operatorPtr->mobileNetworkCode,
+                                &data[offset]))
+        {
+            return LE_BAD_PARAMETER;
+        }
+        offset += PLMN_BYTES;
+    }
+
+    res = pa_sim_SendCommand(LE_SIM_UPDATE_BINARY, "6F7B", 0, 0, len, data, len, NULL,
+                             &sw1, &sw2, resp, &respLen);
+    pa_sim_local_InvalidateEfCache();
+
+    if ((LE_OK != res) || (0x90 != sw1))
+    {
+        LE_ERROR("Failed to update EF FPLMN, SW %02X%02X", sw1, sw2);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -583,13 +824,36 @@ le_result_t __attribute__((weak)) pa_sim_WriteFPLMNList
  *      - LE_UNSUPPORTED    The platform does not support this operation.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_CountFPLMNOperators
+le_result_t pa_sim_CountFPLMNOperators
 (
     uint32_t*  nbItemPtr     ///< [OUT] number of FPLMN operator found if success.
 )
 {
-    LE_UNUSED(nbItemPtr);
-    return LE_UNSUPPORTED;
+    uint8_t     data[EF_RECORD_MAX_BYTES];
+    size_t      len = sizeof(data);
+    size_t      offset;
+
+    if (!nbItemPtr)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (LE_OK != pa_sim_local_ReadEf(PA_SIM_EF_FPLMN, data, &len))
+    {
+        LE_ERROR("Failed to read EF FPLMN");
+        return LE_FAULT;
+    }
+
+    *nbItemPtr = 0;
+    for (offset = 0; (offset + PLMN_BYTES) <= len; offset += PLMN_BYTES)
+    {
+        if (0xFF != data[offset])
+        {
+            (*nbItemPtr)++;
+        }
+    }
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -603,16 +867,45 @@ le_result_t __attribute__((weak)) pa_sim_CountFPLMNOperators
  *      - LE_UNSUPPORTED    The platform does not support this operation.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t __attribute__((weak)) pa_sim_ReadFPLMNOperators
+le_result_t pa_sim_ReadFPLMNOperators
 (
     pa_sim_FPLMNOperator_t* FPLMNOperatorPtr,   ///< [OUT] FPLMN operators.
     uint32_t* FPLMNOperatorCountPtr             ///< [IN/OUT] FPLMN operator count.
 )
 {
-    LE_UNUSED(FPLMNOperatorPtr);
-    LE_UNUSED(FPLMNOperatorCountPtr);
+    uint8_t     data[EF_RECORD_MAX_BYTES];
+    size_t      len = sizeof(data);
+    size_t      offset;
+    uint32_t    count = 0;
 
-    return LE_UNSUPPORTED;
+    if ((!FPLMNOperatorPtr) || (!FPLMNOperatorCountPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (LE_OK != pa_sim_local_ReadEf(PA_SIM_EF_FPLMN, data, &len))
+    {
+        LE_ERROR("Failed to read EF FPLMN");
+        return LE_FAULT;
+    }
+
+    for (offset = 0;
+         ((offset + PLMN_BYTES) <= len) && (count < *FPLMNOperatorCountPtr);
+         offset += PLMN_BYTES)
+    {
+        if (0xFF == data[offset])
+        {
+            continue;
+        }
+
+        DecodePlmn(&data[offset],
+                   FPLMNOperatorPtr[count].mobileCountryCode,
+                   FPLMNOperatorPtr[count].mobileNetworkCode);
+        count++;
+    }
+
+    *FPLMNOperatorCountPtr = count;
+    return (count > 0) ? LE_OK : LE_NOT_FOUND;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -676,24 +969,11 @@ le_result_t pa_sim_EnterPUK
 {
     LE_UNUSED(type);
     char                 command[LE_ATDEFS_COMMAND_MAX_BYTES];
-    le_atClient_CmdRef_t cmdRef = NULL;
     le_result_t          res    = LE_OK;
 
     snprintf(command,LE_ATDEFS_COMMAND_MAX_BYTES,"AT+CPIN=%s,%s",puk,pin);
 
-    res = le_atClient_SetCommandAndSend(&cmdRef,
-                                        pa_utils_GetAtDeviceRef(),
-                                        command,
-                                        "",
-                                        DEFAULT_AT_RESPONSE,
-                                        DEFAULT_AT_CMD_TIMEOUT);
-
-    if (res != LE_OK)
-    {
-        LE_ERROR("Failed to send the command");
-        return res;
-    }
-
-    le_atClient_Delete(cmdRef);
+    res = SendPinCommand(command);
+    pa_sim_local_InvalidateState();
     return res;
 }
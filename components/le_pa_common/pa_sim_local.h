@@ -8,6 +8,37 @@
 
 
 #include "legato.h"
+#include "pa_sim.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM elementary files read by the PA
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PA_SIM_EF_ICCID = 0,    ///< Integrated circuit card identifier
+    PA_SIM_EF_IMSI,         ///< International mobile subscriber identity
+    PA_SIM_EF_MSISDN,       ///< Subscriber phone number, first record
+    PA_SIM_EF_SPN,          ///< Service provider name
+    PA_SIM_EF_FPLMN,        ///< Forbidden PLMNs
+    PA_SIM_EF_MAX
+}
+pa_sim_local_Ef_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SIM slot selection commands. Slot selection is not standardized, the command depends on the
+ * modem vendor.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PA_SIM_SLOT_SELECT_NONE,    ///< Single SIM.
+    PA_SIM_SLOT_SELECT_KSIMSEL, ///< AT+KSIMSEL=<0 external SIM|1 embedded SIM>.
+    PA_SIM_SLOT_SELECT_QDSIM    ///< AT+QDSIM=<0 SIM slot 1|1 SIM slot 2>.
+}
+pa_sim_SlotSelectProfile_t;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -22,4 +53,96 @@ le_result_t pa_sim_Init
     void
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the cached SIM state so that the next pa_sim_GetState() resynchronizes it.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_InvalidateState
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an elementary file of the SIM.
+ *
+ * The content is served from the cache of the inserted card when available.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_NOT_FOUND     The file does not exist on the card.
+ * @return LE_OVERFLOW      The file does not fit in the buffer.
+ * @return LE_FAULT         The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_local_ReadEf
+(
+    pa_sim_local_Ef_t ef,       ///< [IN] Elementary file
+    uint8_t*          dataPtr,  ///< [OUT] File content
+    size_t*           lenPtr    ///< [IN/OUT] File content length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the elementary files cache, e.g. after a SIM refresh or a file update. The files are
+ * read again from the card on their next access.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_InvalidateEfCache
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read again the PIN and PUK remaining attempts table.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_RefreshRemainingAttempts
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the PIN and PUK remaining attempts table, it is read again on its next access.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_InvalidateRemainingAttempts
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the SIM slot selection command of the modem and read the selected slot.
+ *
+ * Only one slot is available when the selected slot cannot be read.
+ */
+//--------------------------------------------------------------------------------------------------
+void pa_sim_local_SetSlotSelectProfile
+(
+    pa_sim_SlotSelectProfile_t profile      ///< [IN] The slot selection command
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the cached identity of the card of a SIM slot, selected or not, without any AT command.
+ *
+ * The ICCID and IMSI are set to an empty string when they are not known.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_BAD_PARAMETER The parameters are invalid.
+ * @return LE_NOT_FOUND     The card of the slot has never been seen.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_local_GetSlotInfo
+(
+    le_sim_Id_t      simId,     ///< [IN] SIM identifier
+    pa_sim_CardId_t  iccid,     ///< [OUT] ICCID value
+    pa_sim_Imsi_t    imsi,      ///< [OUT] IMSI value
+    le_sim_States_t* statePtr   ///< [OUT] Last known SIM state
+);
+
 #endif // LEGATO_PASIMLOCAL_INCLUDE_GUARD
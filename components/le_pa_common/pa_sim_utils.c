@@ -15,6 +15,122 @@
 #include "pa_utils.h"
 #include "pa_sim_utils_local.h"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a line parsed by pa_sim_utils_CheckStatus(), long enough for verbose
+ * +CME ERROR reports
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAXLINE     PA_AT_LOCAL_STRING_SIZE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * +CME ERROR numeric code and its verbose text (3GPP TS 27.007 section 9.2)
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int32_t     code;       ///< Numeric error code
+    const char* textPtr;    ///< Verbose error text
+}
+CmeError_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * +CME ERROR codes reported by the SIM and subscriber related commands
+ */
+//--------------------------------------------------------------------------------------------------
+static const CmeError_t CmeErrors[] =
+{
+    {   0, "phone failure"                   },
+    {   3, "operation not allowed"           },
+    {   4, "operation not supported"         },
+    {   5, "PH-SIM PIN required"             },
+    {  10, "SIM not inserted"                },
+    {  11, "SIM PIN required"                },
+    {  12, "SIM PUK required"                },
+    {  13, "SIM failure"                     },
+    {  14, "SIM busy"                        },
+    {  15, "SIM wrong"                       },
+    {  16, "incorrect password"              },
+    {  17, "SIM PIN2 required"               },
+    {  18, "SIM PUK2 required"               },
+    {  20, "memory full"                     },
+    {  21, "invalid index"                   },
+    {  22, "not found"                       },
+    {  23, "memory failure"                  },
+    {  30, "no network service"              },
+    {  31, "network timeout"                 },
+    { 100, "unknown"                         },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function decodes a +CME ERROR value, reported either in numeric (AT+CMEE=1) or in verbose
+ * (AT+CMEE=2) format.
+ *
+ * @return the numeric error code, -1 if the value is not recognized
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t pa_sim_utils_DecodeCmeError
+(
+    const char* valPtr     ///< [IN] the +CME ERROR value
+)
+{
+    char*    endPtr = NULL;
+    long     code;
+    uint32_t i;
+
+    if ((!valPtr) || (NULL_CHAR == valPtr[0]))
+    {
+        return -1;
+    }
+
+    while (' ' == *valPtr)
+    {
+        valPtr++;
+    }
+
+    code = strtol(valPtr, &endPtr, BASE_DEC);
+    if ((endPtr != valPtr) && (NULL_CHAR == *endPtr))
+    {
+        return (int32_t) code;
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(CmeErrors); i++)
+    {
+        if (0 == strcasecmp(valPtr, CmeErrors[i].textPtr))
+        {
+            return CmeErrors[i].code;
+        }
+    }
+
+    LE_DEBUG("Unknown +CME ERROR value '%s'", valPtr);
+    return -1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function extracts the error code of a +CME ERROR final response.
+ *
+ * @return the numeric error code, -1 if the line is not a recognized +CME ERROR
+ */
+//--------------------------------------------------------------------------------------------------
+int32_t pa_sim_utils_GetCmeErrorCode
+(
+    const char* lineStr    ///< [IN] final response line
+)
+{
+    const char* prefixPtr = "+CME ERROR:";
+
+    if ((!lineStr) || (0 != strncmp(lineStr, prefixPtr, strlen(prefixPtr))))
+    {
+        return -1;
+    }
+
+    return pa_sim_utils_DecodeCmeError(lineStr + strlen(prefixPtr));
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to translate the code status for +CMS ERROR parsing.
@@ -72,7 +188,7 @@ void pa_sim_utils_CheckCmeErrorCode
     le_sim_States_t* statePtr  ///< [OUT] SIM state
 )
 {
-    switch (atoi(valPtr))
+    switch (pa_sim_utils_DecodeCmeError(valPtr))
     {
 
         case 5:     /* PH-SIM PIN required (SIM lock) */
@@ -94,6 +210,11 @@ void pa_sim_utils_CheckCmeErrorCode
             *statePtr = LE_SIM_BLOCKED;
             break;
         }
+        case 14:    /* SIM busy */
+        {
+            *statePtr = LE_SIM_BUSY;
+            break;
+        }
         default:
         {
             *statePtr = LE_SIM_STATE_UNKNOWN;
@@ -157,10 +278,8 @@ bool pa_sim_utils_CheckStatus
 {
     bool result = true;
 
-    #define MAXLINE     18
-
     char line[MAXLINE+1];
-    memcpy(line, lineStr, MAXLINE);
+    strncpy(line, lineStr, MAXLINE);
 
     line[MAXLINE] = '\0';
     *statePtr = LE_SIM_STATE_UNKNOWN;
@@ -190,3 +309,45 @@ bool pa_sim_utils_CheckStatus
 
     return result;
 }
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function decodes digits stored in swapped-nibble BCD, as in the SIM elementary files. The
+ * decoding stops at the first 'F' filler nibble.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_OVERFLOW      The string buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t pa_sim_utils_DecodeBcd
+(
+    const uint8_t* bcdPtr,      ///< [IN] BCD buffer
+    size_t         bcdLen,      ///< [IN] BCD buffer length in bytes
+    char*          strPtr,      ///< [OUT] Digits string
+    size_t         strSize      ///< [IN] Digits string buffer size
+)
+{
+    static const char digits[] = "0123456789*#pwe";
+    size_t            len = 0;
+    size_t            i;
+
+    for (i = 0; i < 2 * bcdLen; i++)
+    {
+        uint8_t nibble = (i & 1) ? (bcdPtr[i / 2] >> 4) : (bcdPtr[i / 2] & 0x0F);
+
+        if (0x0F == nibble)
+        {
+            break;
+        }
+
+        if ((len + 1) >= strSize)
+        {
+            strPtr[len] = NULL_CHAR;
+            return LE_OVERFLOW;
+        }
+        strPtr[len++] = digits[nibble];
+    }
+
+    strPtr[len] = NULL_CHAR;
+    return LE_OK;
+}
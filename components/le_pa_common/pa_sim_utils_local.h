@@ -9,6 +9,31 @@
 #define LEGATO_PASIMUTILSLOCAL_INCLUDE_GUARD
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function decodes a +CME ERROR value, reported either in numeric (AT+CMEE=1) or in verbose
+ * (AT+CMEE=2) format.
+ *
+ * @return the numeric error code, -1 if the value is not recognized
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int32_t pa_sim_utils_DecodeCmeError
+(
+    const char* valPtr     ///< [IN] the +CME ERROR value
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function extracts the error code of a +CME ERROR final response.
+ *
+ * @return the numeric error code, -1 if the line is not a recognized +CME ERROR
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED int32_t pa_sim_utils_GetCmeErrorCode
+(
+    const char* lineStr    ///< [IN] final response line
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to translate the code status for +CMS ERROR parsing.
@@ -60,5 +85,21 @@ LE_SHARED bool pa_sim_utils_CheckStatus
     le_sim_States_t* statePtr   ///< [OUT] SIM state
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function decodes digits stored in swapped-nibble BCD, as in the SIM elementary files. The
+ * decoding stops at the first 'F' filler nibble.
+ *
+ * @return LE_OK            The function succeeded.
+ * @return LE_OVERFLOW      The string buffer is too small.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t pa_sim_utils_DecodeBcd
+(
+    const uint8_t* bcdPtr,      ///< [IN] BCD buffer
+    size_t         bcdLen,      ///< [IN] BCD buffer length in bytes
+    char*          strPtr,      ///< [OUT] Digits string
+    size_t         strSize      ///< [IN] Digits string buffer size
+);
 
 #endif // LEGATO_PASIMUTILSLOCAL_INCLUDE_GUARD
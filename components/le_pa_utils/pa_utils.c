@@ -22,10 +22,17 @@ static le_atClient_DeviceRef_t AtDeviceRef = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Device reference used for PPP session
+ * Device references used for PPP sessions, one per concurrent data session
  */
 //--------------------------------------------------------------------------------------------------
-static le_atClient_DeviceRef_t PppDeviceRef = NULL;
+static le_atClient_DeviceRef_t PppDeviceRef[PA_AT_PPP_PORT_MAX] = { NULL };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CMEE mode configured on the modem, -1 until it is known
+ */
+//--------------------------------------------------------------------------------------------------
+static int32_t CmeeMode = -1;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -405,6 +412,7 @@ void pa_utils_RemoveSpaceInString
 /**
  * This function must be called to get the CMEE mode
  *
+ * The modem is only queried while the mode set by pa_utils_SetCmeeMode() is not known.
  */
 //--------------------------------------------------------------------------------------------------
 int32_t pa_utils_GetCmeeMode
@@ -414,6 +422,12 @@ int32_t pa_utils_GetCmeeMode
 {
     int32_t cmeeMode = 0;
     char localBuffStr[PA_AT_LOCAL_SHORT_SIZE] = {0};
+
+    if (CmeeMode >= 0)
+    {
+        return CmeeMode;
+    }
+
     // AT+CMEE?
     // +CMEE: 1
     // OK
@@ -427,6 +441,7 @@ int32_t pa_utils_GetCmeeMode
         {
             cmeeMode = 0;
         }
+        CmeeMode = cmeeMode;
     }
 
     return cmeeMode;
@@ -436,9 +451,12 @@ int32_t pa_utils_GetCmeeMode
 /**
  * This function must be called to set the CMEE mode
  *
+ * @return
+ *  - LE_FAULT  Function failed.
+ *  - LE_OK     Function succeeded.
  */
 //--------------------------------------------------------------------------------------------------
-void pa_utils_SetCmeeMode
+le_result_t pa_utils_SetCmeeMode
 (
     int32_t cmeeMode
 )
@@ -446,8 +464,14 @@ void pa_utils_SetCmeeMode
     char localBuffStr[PA_AT_LOCAL_SHORT_SIZE];
     snprintf(localBuffStr, sizeof(localBuffStr), "AT+CMEE=%" PRIi32, cmeeMode);
 
-    pa_utils_GetATIntermediateResponse(localBuffStr, DEFAULT_EMPTY_INTERMEDIATE,
-        localBuffStr, sizeof(localBuffStr));
+    if (LE_OK != pa_utils_SendATCommandOK(localBuffStr))
+    {
+        CmeeMode = -1;
+        return LE_FAULT;
+    }
+
+    CmeeMode = cmeeMode;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -490,7 +514,7 @@ void pa_utils_SetPppDeviceRef
     le_atClient_DeviceRef_t pppDeviceRef
 )
 {
-    PppDeviceRef = pppDeviceRef;
+    PppDeviceRef[0] = pppDeviceRef;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -504,7 +528,47 @@ le_atClient_DeviceRef_t pa_utils_GetPppDeviceRef
     void
 )
 {
-    return PppDeviceRef;
+    return PppDeviceRef[0];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is used to set the device reference of a PPP port.
+ *
+ **/
+//--------------------------------------------------------------------------------------------------
+void pa_utils_SetPppDeviceRefByIndex
+(
+    uint32_t                portIndex,
+    le_atClient_DeviceRef_t pppDeviceRef
+)
+{
+    if (portIndex >= PA_AT_PPP_PORT_MAX)
+    {
+        LE_ERROR("Invalid PPP port index %"PRIu32, portIndex);
+        return;
+    }
+
+    PppDeviceRef[portIndex] = pppDeviceRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is used to get the device reference of a PPP port.
+ *
+ **/
+//--------------------------------------------------------------------------------------------------
+le_atClient_DeviceRef_t pa_utils_GetPppDeviceRefByIndex
+(
+    uint32_t portIndex
+)
+{
+    if (portIndex >= PA_AT_PPP_PORT_MAX)
+    {
+        return NULL;
+    }
+
+    return PppDeviceRef[portIndex];
 }
 
 COMPONENT_INIT
@@ -118,6 +118,13 @@
 //--------------------------------------------------------------------------------------------------
 #define PA_AT_LOCAL_SHORT_SIZE          50
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of PPP ports, i.e. of concurrent data sessions
+ */
+//--------------------------------------------------------------------------------------------------
+#define PA_AT_PPP_PORT_MAX              4
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to count the number of parameters in a line, between ',' and ':' and to set
@@ -257,9 +264,12 @@ LE_SHARED int32_t  pa_utils_GetCmeeMode
 /**
  * This function must be called to set the CMEE mode
  *
+ * @return
+ *  - LE_FAULT  Function failed.
+ *  - LE_OK     Function succeeded.
  */
 //--------------------------------------------------------------------------------------------------
-LE_SHARED void  pa_utils_SetCmeeMode
+LE_SHARED le_result_t  pa_utils_SetCmeeMode
 (
     int32_t cmeeMode
 );
@@ -333,4 +343,40 @@ LE_SHARED char* pa_utils_GetPppPath
     void
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is used to get the device reference of a PPP port.
+ *
+ * @return the device reference, NULL if the port is not available
+ **/
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_atClient_DeviceRef_t pa_utils_GetPppDeviceRefByIndex
+(
+    uint32_t portIndex                          ///< [IN] PPP port index
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is used to set the device reference of a PPP port.
+ *
+ **/
+//--------------------------------------------------------------------------------------------------
+LE_SHARED void pa_utils_SetPppDeviceRefByIndex
+(
+    uint32_t                portIndex,          ///< [IN] PPP port index
+    le_atClient_DeviceRef_t pppDeviceRef        ///< [IN] Device reference of the port
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is used to get the path of a PPP port.
+ *
+ * @return the port path, NULL if the port is not configured
+ **/
+//--------------------------------------------------------------------------------------------------
+LE_SHARED char* pa_utils_GetPppPathByIndex
+(
+    uint32_t portIndex                          ///< [IN] PPP port index
+);
+
 #endif // LEGATO_PAUTILS_INCLUDE_GUARD